@@ -0,0 +1,425 @@
+#include "archive.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr std::int64_t kNsecSec = 1000000000;  // Nanoseconds in a second
+
+/*
+ * @brief      計算: 時刻（先頭時刻 + 時刻間隔 * 件番号）
+ *
+ * @param[in]  ヘッダ (ArcHeader)
+ * @param[in]  件番号 (uint64_t)
+ * @return     時刻 (timespec)
+ */
+static struct timespec calc_ts(const ArcHeader& hdr, std::uint64_t i) {
+  struct timespec ts;
+  std::int64_t    ns;
+
+  ns = hdr.t0_nsec + hdr.step_nsec * static_cast<std::int64_t>(i);
+  ts.tv_sec  = hdr.t0_sec + ns / kNsecSec;
+  ts.tv_nsec = ns % kNsecSec;
+
+  return ts;
+}
+
+/*
+ * @brief       符号化: 1列分
+ *              * 値のビット列を整数とみなした2階差分（直前の差分との差）を
+ *                ジグザグ符号化し、上位の 0 バイトを除いた下位バイトのみを出力する。
+ *                （件数 2 件毎に、各々のバイト数(0 - 8)を 4 bit ずつ 1 バイトで先行させる）
+ *              * 滑らかに変化する値では2階差分が小さくなるため圧縮される。（可逆）
+ *
+ * @param[in]   値の配列 (const double*)
+ * @param[in]   件数 (size_t)
+ * @param[ref]  出力先 (vector<unsigned char>)
+ * @return      <none>
+ */
+void enc_col(const double* v, std::size_t n, std::vector<unsigned char>& out) {
+  std::uint64_t prev = 0;  // 直前の値（ビット列）
+  std::uint64_t d    = 0;  // 直前の差分
+  std::uint64_t cur;       // 現在の値（ビット列）
+  std::uint64_t dd;        // 2階差分
+  std::uint64_t x[2];      // 2階差分（ジグザグ符号化後）
+  unsigned int  nb[2];     // 有効バイト数
+  std::size_t   i;
+  unsigned int  j;
+  unsigned int  k;
+
+  for (i = 0; i < n; i += 2) {
+    for (j = 0; j < 2; ++j) {
+      x[j]  = 0;
+      nb[j] = 0;
+      if (i + j >= n) continue;
+      std::memcpy(&cur, &v[i + j], sizeof(cur));
+      dd   = (cur - prev) - d;
+      d    = cur - prev;
+      prev = cur;
+      x[j] = (dd << 1) ^ (0 - (dd >> 63));
+      while (nb[j] < 8 && (x[j] >> (nb[j] * 8)) != 0) ++nb[j];
+    }
+    out.push_back(static_cast<unsigned char>(nb[0] | (nb[1] << 4)));
+    for (j = 0; j < 2; ++j) {
+      for (k = 0; k < nb[j]; ++k) {
+        out.push_back(static_cast<unsigned char>(x[j] >> (k * 8)));
+      }
+    }
+  }
+}
+
+/*
+ * @brief       復号: 1列分（enc_col の逆変換）
+ *
+ * @param[in]   入力位置 (const unsigned char*)
+ * @param[in]   入力終端 (const unsigned char*)
+ * @param[in]   件数 (size_t)
+ * @param[out]  値の配列 (double*)
+ * @return      次の入力位置 (const unsigned char*; 入力が不足する場合 nullptr)
+ */
+const unsigned char* dec_col(const unsigned char* q, const unsigned char* end,
+                             std::size_t n, double* v) {
+  std::uint64_t prev = 0;  // 直前の値（ビット列）
+  std::uint64_t d    = 0;  // 直前の差分
+  std::uint64_t x;         // 2階差分（ジグザグ符号化後）
+  unsigned int  nb[2];     // 有効バイト数
+  std::size_t   i;
+  unsigned int  j;
+  unsigned int  k;
+
+  for (i = 0; i < n; i += 2) {
+    if (q >= end) return nullptr;
+    nb[0] = *q & 0x0f;
+    nb[1] = *q >> 4;
+    ++q;
+    for (j = 0; j < 2 && i + j < n; ++j) {
+      if (nb[j] > 8 || end - q < static_cast<std::ptrdiff_t>(nb[j])) {
+        return nullptr;
+      }
+      x = 0;
+      for (k = 0; k < nb[j]; ++k) {
+        x |= static_cast<std::uint64_t>(*q++) << (k * 8);
+      }
+      d    += (x >> 1) ^ (0 - (x & 1));
+      prev += d;
+      std::memcpy(&v[i + j], &prev, sizeof(prev));
+    }
+  }
+
+  return q;
+}
+
+/*
+ * @brief      生成: アーカイブ（一括計算・書き込み）
+ *             * 先頭時刻から一定間隔の各時刻を計算し、チャンク単位で符号化して書き込む。
+ *             * 計算・符号化は複数スレッドで行い、書き込みと並行させる。
+ *               処理中のチャンク数はスレッド数の 2 倍までとし、メモリ使用量を抑える。
+ *             * 形式: ヘッダ(ArcHeader), チャンク(値毎の enc_col の出力を連結),
+ *                     索引(ArcIndex; チャンク数分)
+ *
+ * @param[in]  係数 (Param)
+ * @param[in]  先頭時刻（UT1） (timespec)
+ * @param[in]  時刻間隔（ナノ秒） (long long)
+ * @param[in]  件数 (size_t)
+ * @param[in]  ファイル名 (string)
+ * @param[in]  チャンクあたりの件数 (uint32_t)
+ * @param[in]  スレッド数 (unsigned int; 0: ハードウェアのスレッド数)
+ * @return     <none>
+ */
+void write_archive(const Param& prm, struct timespec t0, long long step,
+                   std::size_t n, const std::string& f,
+                   std::uint32_t n_per_chunk, unsigned int n_thread) {
+  // スロット（計算済みチャンクの受け渡し）
+  struct Slot {
+    std::vector<unsigned char> buf;  // 符号化済みデータ
+    std::uint64_t chunk = 0;         // チャンク番号
+    bool done = false;               // 計算済み
+  };
+  ArcHeader hdr = {};
+  std::vector<ArcIndex> idx;
+  std::vector<Slot> slots;
+  std::vector<std::thread> ths;
+  std::vector<unsigned char> wbuf;
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::uint64_t next    = 0;  // 次に計算するチャンク
+  std::uint64_t written = 0;  // 書き込み済みチャンク数
+  std::uint64_t window;       // 処理中チャンク数（最大）
+  std::uint64_t off;
+  std::uint64_t c;
+  unsigned int  i;
+
+  try {
+    if (step <= 0 || n_per_chunk == 0) {
+      std::cout << "[ERROR] Invalid archive parameter!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::memcpy(hdr.magic, kArcMagic, sizeof(hdr.magic));
+    hdr.n_val       = kNumVal;
+    hdr.n_per_chunk = n_per_chunk;
+    hdr.t0_sec      = t0.tv_sec;
+    hdr.t0_nsec     = t0.tv_nsec;
+    hdr.step_nsec   = step;
+    hdr.n           = n;
+    hdr.n_chunk     = (n + n_per_chunk - 1) / n_per_chunk;
+    idx.resize(hdr.n_chunk);
+
+    // ファイル OPEN（ヘッダは最後に書き直す）
+    std::ofstream ofs(f, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      std::cout << "[ERROR] Could not open \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    off = sizeof(hdr);
+
+    // 計算スレッド
+    if (n_thread == 0) n_thread = std::thread::hardware_concurrency();
+    if (n_thread == 0) n_thread = 1;
+    window = n_thread * 2;
+    slots.resize(window);
+    for (i = 0; i < n_thread; ++i) {
+      ths.emplace_back([&]() {
+        std::unique_ptr<EphJcg> o_e(new EphJcg(prm));
+        std::vector<double> col(static_cast<std::size_t>(kNumVal) * n_per_chunk);
+        std::vector<struct timespec> tss(n_per_chunk);
+        std::vector<Result> res(n_per_chunk);
+        std::vector<unsigned char> out;
+        std::uint64_t c;
+        std::uint64_t j;
+        std::uint64_t m;
+        unsigned int  v;
+
+        for (;;) {
+          {
+            std::unique_lock<std::mutex> lk(mtx);
+            cv.wait(lk, [&] {
+              return next >= hdr.n_chunk || next < written + window;
+            });
+            if (next >= hdr.n_chunk) return;
+            c = next++;
+          }
+          m = std::min<std::uint64_t>(n_per_chunk, hdr.n - c * n_per_chunk);
+          for (j = 0; j < m; ++j) tss[j] = calc_ts(hdr, c * n_per_chunk + j);
+          o_e->calc(tss.data(), m, res.data());
+          for (j = 0; j < m; ++j) {
+            for (v = 0; v < kNumVal; ++v) {
+              col[v * n_per_chunk + j] = get_val(res[j], v);
+            }
+          }
+          out.clear();
+          for (v = 0; v < kNumVal; ++v) {
+            enc_col(&col[v * n_per_chunk], m, out);
+          }
+          {
+            std::lock_guard<std::mutex> lk(mtx);
+            Slot& s = slots[c % window];
+            s.buf.swap(out);
+            s.chunk = c;
+            s.done  = true;
+          }
+          cv.notify_all();
+        }
+      });
+    }
+
+    // 書き込み（チャンク番号順）
+    for (c = 0; c < hdr.n_chunk; ++c) {
+      {
+        std::unique_lock<std::mutex> lk(mtx);
+        Slot& s = slots[c % window];
+        cv.wait(lk, [&] { return s.done && s.chunk == c; });
+        wbuf.swap(s.buf);
+        s.done = false;
+      }
+      ofs.write(reinterpret_cast<const char*>(wbuf.data()), wbuf.size());
+      idx[c].off  = off;
+      idx[c].size = wbuf.size();
+      off += wbuf.size();
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+        written = c + 1;
+      }
+      cv.notify_all();
+    }
+    for (auto& th : ths) th.join();
+
+    // 索引（8 バイト境界に揃える）、ヘッダ
+    while (off % alignof(ArcIndex) != 0) {
+      ofs.put('\0');
+      ++off;
+    }
+    hdr.idx_off = off;
+    ofs.write(reinterpret_cast<const char*>(idx.data()),
+              idx.size() * sizeof(ArcIndex));
+    ofs.seekp(0);
+    ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    if (!ofs) {
+      std::cout << "[ERROR] Could not write \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  コンストラクタ
+ *         * ファイルをメモリマップし、ヘッダ・索引を検証する。
+ *           （時刻間隔が正でない、チャンク数が件数と合わない場合も不正とする）
+ *         * 展開済みチャンクを保持するため、スレッド毎にインスタンスを作成すること。
+ *
+ * @param[in]  ファイル名 (string)
+ */
+ArcReader::ArcReader(const std::string& f)
+    : fd(-1), p(nullptr), sz(0), hdr(), idx(nullptr), i_chunk(0) {
+  struct stat st;
+  void* m;
+
+  try {
+    fd = open(f.c_str(), O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+      std::cout << "[ERROR] Could not open \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    sz = st.st_size;
+    if (sz < sizeof(hdr)) {
+      std::cout << "[ERROR] Invalid archive \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    m = mmap(nullptr, sz, PROT_READ, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED) {
+      std::cout << "[ERROR] Could not map \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    p = static_cast<const unsigned char*>(m);
+    std::memcpy(&hdr, p, sizeof(hdr));
+    if (std::memcmp(hdr.magic, kArcMagic, sizeof(hdr.magic)) != 0 ||
+        hdr.n_val != kNumVal || hdr.n_per_chunk == 0 || hdr.step_nsec <= 0 ||
+        hdr.n_chunk != hdr.n / hdr.n_per_chunk + (hdr.n % hdr.n_per_chunk != 0) ||
+        hdr.idx_off % alignof(ArcIndex) != 0 || hdr.idx_off > sz ||
+        (sz - hdr.idx_off) / sizeof(ArcIndex) < hdr.n_chunk) {
+      std::cout << "[ERROR] Invalid archive \"" << f << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    idx = reinterpret_cast<const ArcIndex*>(p + hdr.idx_off);
+    i_chunk = hdr.n_chunk;
+    buf.resize(static_cast<std::size_t>(kNumVal) * hdr.n_per_chunk);
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  デストラクタ
+ */
+ArcReader::~ArcReader() {
+  if (p != nullptr) munmap(const_cast<unsigned char*>(p), sz);
+  if (fd >= 0) close(fd);
+}
+
+/*
+ * @brief   件数
+ *
+ * @param   <none>
+ * @return  件数 (size_t)
+ */
+std::size_t ArcReader::size() const {
+  return hdr.n;
+}
+
+/*
+ * @brief      時刻（件番号指定）
+ *
+ * @param[in]  件番号 (size_t)
+ * @return     時刻（UT1） (timespec)
+ */
+struct timespec ArcReader::time(std::size_t i) const {
+  return calc_ts(hdr, i);
+}
+
+/*
+ * @brief       取得: 件番号指定
+ *
+ * @param[in]   件番号 (size_t)
+ * @param[ref]  計算結果 (Result)
+ * @return      true: 成功, false: 範囲外・データ不正
+ */
+bool ArcReader::get(std::size_t i, Result& res) {
+  std::uint64_t c;
+  std::uint64_t j;
+  unsigned int  v;
+
+  if (i >= hdr.n) return false;
+  c = i / hdr.n_per_chunk;
+  j = i % hdr.n_per_chunk;
+  if (c != i_chunk && !load_chunk(c)) return false;
+  for (v = 0; v < kNumVal; ++v) {
+    set_val(res, v, buf[v * hdr.n_per_chunk + j]);
+  }
+
+  return true;
+}
+
+/*
+ * @brief       取得: 時刻指定
+ *              * 指定時刻以前で最も近い時刻の値を取得する。
+ *
+ * @param[in]   時刻（UT1） (timespec)
+ * @param[ref]  計算結果 (Result)
+ * @return      true: 成功, false: 範囲外・データ不正
+ */
+bool ArcReader::get(struct timespec ts, Result& res) {
+  std::int64_t ns;
+
+  ns = (static_cast<std::int64_t>(ts.tv_sec) - hdr.t0_sec) * kNsecSec
+     + (ts.tv_nsec - hdr.t0_nsec);
+  if (ns < 0) return false;
+
+  return get(static_cast<std::size_t>(ns / hdr.step_nsec), res);
+}
+
+/*
+ * @brief      展開: チャンク
+ *
+ * @param[in]  チャンク番号 (uint64_t)
+ * @return     true: 成功, false: データ不正
+ */
+bool ArcReader::load_chunk(std::uint64_t c) {
+  const unsigned char* q;
+  const unsigned char* end;
+  std::uint64_t m;
+  unsigned int  v;
+
+  if (idx[c].off > sz || idx[c].size > sz - idx[c].off) return false;
+  q   = p + idx[c].off;
+  end = q + idx[c].size;
+  m   = std::min<std::uint64_t>(hdr.n_per_chunk, hdr.n - c * hdr.n_per_chunk);
+  for (v = 0; v < kNumVal; ++v) {
+    q = dec_col(q, end, m, &buf[v * hdr.n_per_chunk]);
+    if (q == nullptr) {
+      i_chunk = hdr.n_chunk;
+      return false;
+    }
+  }
+  i_chunk = c;
+
+  return true;
+}
+
+}  // namespace ephemeris_jcg
+
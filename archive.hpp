@@ -0,0 +1,87 @@
+#ifndef EPHEMERIS_JCG_ARCHIVE_HPP_
+#define EPHEMERIS_JCG_ARCHIVE_HPP_
+
+#include "eph_jcg.hpp"
+#include "file.hpp"
+#include "result.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr char          kArcMagic[8] = {'E', 'P', 'H', 'J', 'C', 'G', 'A', '1'};
+static constexpr std::uint32_t kArcChunk    = 3600;  // チャンクあたりの件数（既定）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// アーカイブ: ヘッダ（ファイル先頭）
+// * 数値はすべて実行環境のバイト順で格納する。
+struct ArcHeader {
+  char          magic[8];     // 識別子
+  std::uint32_t n_val;        // 値の数（kNumVal）
+  std::uint32_t n_per_chunk;  // チャンクあたりの件数
+  std::int64_t  t0_sec;       // 先頭時刻（UT1; 秒）
+  std::int64_t  t0_nsec;      // 先頭時刻（UT1; ナノ秒）
+  std::int64_t  step_nsec;    // 時刻間隔（ナノ秒）
+  std::uint64_t n;            // 件数
+  std::uint64_t n_chunk;      // チャンク数
+  std::uint64_t idx_off;      // 索引の位置（ファイル先頭からのバイト数）
+};
+
+// アーカイブ: 索引（チャンク毎; ファイル末尾）
+struct ArcIndex {
+  std::uint64_t off;          // チャンクの位置（ファイル先頭からのバイト数）
+  std::uint64_t size;         // チャンクのバイト数
+};
+
+// -------------------------------------
+//   Functions
+// -------------------------------------
+// 符号化・復号: 1列分（2階差分・ジグザグ符号化）
+void enc_col(const double*, std::size_t, std::vector<unsigned char>&);
+const unsigned char* dec_col(const unsigned char*, const unsigned char*,
+                             std::size_t, double*);
+// 生成: アーカイブ（一括計算・書き込み）
+void write_archive(const Param&, struct timespec, long long, std::size_t,
+                   const std::string&, std::uint32_t = kArcChunk,
+                   unsigned int = 0);
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// アーカイブ読み込み（メモリマップ; ランダムアクセス）
+class ArcReader {
+  int fd;                       // ファイルディスクリプタ
+  const unsigned char* p;       // マップ先頭
+  std::size_t sz;               // マップサイズ
+  ArcHeader hdr;                // ヘッダ
+  const ArcIndex* idx;          // 索引
+  std::uint64_t i_chunk;        // 展開済みチャンク（未展開: hdr.n_chunk）
+  std::vector<double> buf;      // 展開済みチャンク（列指向）
+
+public:
+  ArcReader(const std::string&);              // コンストラクタ
+  ~ArcReader();                               // デストラクタ
+  ArcReader(const ArcReader&) = delete;
+  ArcReader& operator=(const ArcReader&) = delete;
+  std::size_t size() const;                   // 件数
+  struct timespec time(std::size_t) const;    // 時刻（件番号指定）
+  bool get(std::size_t, Result&);             // 取得: 件番号指定
+  bool get(struct timespec, Result&);         // 取得: 時刻指定（直前の時刻）
+
+private:
+  bool load_chunk(std::uint64_t);             // 展開: チャンク
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,204 @@
+#include "async.hpp"
+
+#include "common.hpp"
+#include "eph_jcg.hpp"
+
+#include <algorithm>
+#include <cstdlib>   // for EXIT_XXXX
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ephemeris_jcg {
+
+/*
+ * @brief  コンストラクタ
+ *         * 計算スレッドを開始する。
+ *
+ * @param[in]  係数・ΔT の保持 (Store&)
+ * @param[in]  バッチの最大件数 (size_t)
+ * @param[in]  待ち時間の上限 (unsigned int; マイクロ秒)
+ */
+AsyncEph::AsyncEph(Store& st, std::size_t n_max, unsigned int wait_us)
+    : st(st), n_max(n_max), wait(wait_us), stop(false),
+      n_req(0), n_batch(0), n_big(0) {
+  try {
+    if (n_max == 0) {
+      std::cout << "[ERROR] Invalid batch size!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    pend.reserve(n_max);
+    th = std::thread(&AsyncEph::run, this);
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  デストラクタ
+ *         * 受け付け済みの要求を全て計算してから、計算スレッドを停止する。
+ */
+AsyncEph::~AsyncEph() {
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    stop = true;
+  }
+  cv.notify_one();
+  if (th.joinable()) th.join();
+}
+
+/*
+ * @brief      要求
+ *             * 計算スレッドを起こすのは、最初の要求（待ち時間の計測開始）と
+ *               最大件数に達した時のみ。（それ以外は待ち時間の上限で自ら起きる）
+ *
+ * @param[in]  UT1 (timespec)
+ * @return     計算結果 (future<Result>)
+ */
+std::future<Result> AsyncEph::submit(struct timespec ts) {
+  std::future<Result> fut;
+
+  try {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (pend.empty()) {
+      t_old = std::chrono::steady_clock::now();
+      cv.notify_one();  // 待ち時間の計測開始
+    }
+    pend.emplace_back();
+    pend.back().ts = ts;
+    fut = pend.back().prom.get_future();
+    if (pend.size() == n_max) cv.notify_one();
+  } catch (...) {
+    throw;
+  }
+
+  return fut;
+}
+
+/*
+ * @brief      取得: 計算した要求の数
+ *
+ * @param[in]  <none>
+ * @return     計算した要求の数 (uint64_t)
+ */
+std::uint64_t AsyncEph::get_n_req() {
+  std::lock_guard<std::mutex> lk(mtx);
+  return n_req;
+}
+
+/*
+ * @brief      取得: 計算したバッチの数
+ *
+ * @param[in]  <none>
+ * @return     計算したバッチの数 (uint64_t)
+ */
+std::uint64_t AsyncEph::get_n_batch() {
+  std::lock_guard<std::mutex> lk(mtx);
+  return n_batch;
+}
+
+/*
+ * @brief      取得: 最大のバッチの件数
+ *
+ * @param[in]  <none>
+ * @return     最大のバッチの件数 (size_t)
+ */
+std::size_t AsyncEph::get_max_batch() {
+  std::lock_guard<std::mutex> lk(mtx);
+  return n_big;
+}
+
+/*
+ * @brief      計算スレッド
+ *             * 要求が無ければ待ち、あれば最大件数か待ち時間の上限まで待つ。
+ *             * 最大件数を超える分は次のバッチに回す。（受け付け順を保つ）
+ *               （既に待ち時間の上限を過ぎているので、続けて計算する）
+ *
+ * @param[in]  <none>
+ * @return     <none>
+ */
+void AsyncEph::run() {
+  std::vector<Req> b;  // バッチ
+
+  b.reserve(n_max);
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lk(mtx);
+      cv.wait(lk, [this]() { return stop || !pend.empty(); });
+      cv.wait_until(lk, t_old + wait,
+                    [this]() { return stop || pend.size() >= n_max; });
+      if (pend.empty()) break;  // 停止要求（受け付け済みの要求無し）
+      if (pend.size() <= n_max) {
+        b.swap(pend);
+      } else {
+        b.assign(std::make_move_iterator(pend.begin()),
+                 std::make_move_iterator(pend.begin() + n_max));
+        pend.erase(pend.begin(), pend.begin() + n_max);
+      }
+    }
+    eval(b);
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      n_req += b.size();
+      ++n_batch;
+      if (n_big < b.size()) n_big = b.size();
+    }
+    b.clear();
+  }
+}
+
+/*
+ * @brief       計算: 1バッチ
+ *              * 時刻順に並べ替えて ts2tf で一括変換し、年が変わるまで同じ係数・
+ *                EphJcg で計算する。（時刻順なので、適用期間は続けて使われ、
+ *                EphJcg の適用期間の検索も省かれる）
+ *
+ * @param[ref]  バッチ (vector<Req>)
+ * @return      <none>
+ */
+void AsyncEph::eval(std::vector<Req>& b) {
+  const std::size_t n = b.size();
+  std::unique_ptr<EphJcg> o_e;  // 計算
+  const Param* prm = nullptr;   // 係数
+  Result res;                   // 計算結果
+  std::size_t i;
+
+  idx.resize(n);
+  ts.resize(n);
+  y.resize(n);
+  t.resize(n);
+  f.resize(n);
+  for (i = 0; i < n; ++i) idx[i] = i;
+  std::sort(idx.begin(), idx.end(), [&b](std::size_t x, std::size_t z) {
+    return b[x].ts.tv_sec != b[z].ts.tv_sec ? b[x].ts.tv_sec < b[z].ts.tv_sec
+                                            : b[x].ts.tv_nsec < b[z].ts.tv_nsec;
+  });
+  for (i = 0; i < n; ++i) ts[i] = b[idx[i]].ts;
+  ts2tf(ts.data(), n, y.data(), t.data(), f.data());
+
+  Store::Reader rd(st);
+  for (i = 0; i < n; ++i) {
+    Req& r = b[idx[i]];
+    try {
+      if (prm == nullptr || static_cast<int>(prm->year) != y[i]) {
+        o_e.reset();
+        prm = rd.find(y[i]);
+        if (prm == nullptr) {
+          throw std::out_of_range(std::to_string(y[i]) + " is out of range!");
+        }
+        o_e.reset(new EphJcg(*prm));
+      }
+      o_e->calc(y[i], t[i], f[i], res);
+      r.prom.set_value(res);
+    } catch (...) {
+      r.prom.set_exception(std::current_exception());
+    }
+  }
+}
+
+}  // namespace ephemeris_jcg
+
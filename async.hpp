@@ -0,0 +1,80 @@
+#ifndef EPHEMERIS_JCG_ASYNC_HPP_
+#define EPHEMERIS_JCG_ASYNC_HPP_
+
+#include "result.hpp"
+#include "store.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr std::size_t  kAsyncBatch = 256;  // バッチの最大件数（既定）
+static constexpr unsigned int kAsyncWait  = 200;  // 待ち時間の上限（既定; マイクロ秒）
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 非同期計算（要求の集約）
+// * 多数のスレッドからの1時刻ずつの要求を受け付け、future で結果を返す。
+// * 受け付けた要求は計算スレッドが集約し、最大件数に達するか、最も古い要求から
+//   待ち時間の上限が経過した時点でバッチとして計算する。
+//   - バッチ内は時刻順に並べ替えて ts2tf で一括変換し、年（係数）・適用期間が
+//     続けて使われるようにする。
+//   - Store の読み取りはバッチ毎に1回、計算は年毎に1つの EphJcg で行う。
+// * 係数の無い年の要求は、future に例外（std::out_of_range）を設定する。
+// * デストラクタは受け付け済みの要求を全て計算してから終了する。
+class AsyncEph {
+  struct Req {
+    struct timespec ts;           // UT1
+    std::promise<Result> prom;    // 結果の設定先
+  };
+
+  Store& st;                                    // 係数・ΔT の保持
+  std::size_t n_max;                            // バッチの最大件数
+  std::chrono::microseconds wait;               // 待ち時間の上限
+  std::vector<Req> pend;                        // 受け付け済みの要求
+  std::chrono::steady_clock::time_point t_old;  // 最も古い要求の受け付け時刻
+  std::mutex mtx;                               // 排他
+  std::condition_variable cv;                   // 要求の通知
+  bool stop;                                    // 停止要求
+  std::uint64_t n_req;                          // 計算した要求の数
+  std::uint64_t n_batch;                        // 計算したバッチの数
+  std::size_t n_big;                            // 最大のバッチの件数
+  std::vector<std::size_t> idx;                 // 計算用: 時刻順の添字
+  std::vector<struct timespec> ts;              // 計算用: UT1（時刻順）
+  std::vector<int> y;                           // 計算用: 西暦年
+  std::vector<unsigned int> t;                  // 計算用: 通日 T
+  std::vector<double> f;                        // 計算用: UT1 の日の端数 F
+  std::thread th;                               // 計算スレッド
+
+public:
+  AsyncEph(Store&, std::size_t = kAsyncBatch,
+           unsigned int = kAsyncWait);      // コンストラクタ
+  ~AsyncEph();                              // デストラクタ
+  AsyncEph(const AsyncEph&) = delete;
+  AsyncEph& operator=(const AsyncEph&) = delete;
+  std::future<Result> submit(struct timespec);  // 要求
+  std::uint64_t get_n_req();                // 取得: 計算した要求の数
+  std::uint64_t get_n_batch();              // 取得: 計算したバッチの数
+  std::size_t get_max_batch();              // 取得: 最大のバッチの件数
+
+private:
+  void run();                               // 計算スレッド
+  void eval(std::vector<Req>&);             // 計算: 1バッチ
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
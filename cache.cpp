@@ -0,0 +1,217 @@
+#include "cache.hpp"
+
+#include "common.hpp"
+#include "eph_jcg.hpp"
+
+#include <cstdlib>   // for EXIT_XXXX
+#include <iostream>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr std::int64_t kNsecSec = 1000000000;  // Nanoseconds in a second
+
+/*
+ * @brief      計算: ハッシュ値
+ *             * 64 bit の混合（splitmix64 の最終段）。
+ *
+ * @param[in]  値 (uint64_t)
+ * @return     ハッシュ値 (uint64_t)
+ */
+static std::uint64_t calc_hash(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+
+  return x;
+}
+
+/*
+ * @brief       複写: 指定の値のみ
+ *
+ * @param[in]   複写元 (Result)
+ * @param[in]   値の指定 (uint64_t; 1 << Val)
+ * @param[ref]  複写先 (Result)
+ * @return      <none>
+ */
+static void copy_val(const Result& src, std::uint64_t mask, Result& dst) {
+  unsigned int i;
+
+  if ((mask & kMaskAll) == kMaskAll) {
+    dst = src;
+    return;
+  }
+  for (i = 0; i < kNumVal; ++i) {
+    if (mask >> i & 1) set_val(dst, i, get_val(src, i));
+  }
+}
+
+/*
+ * @brief  コンストラクタ
+ *         * 容量はストライプ数 * kCacheWay の倍数に切り上げる。
+ *
+ * @param[in]  係数・ΔT の保持 (Store&)
+ * @param[in]  量子化の幅（ナノ秒） (int64_t)
+ * @param[in]  容量（エントリ数） (size_t)
+ * @param[in]  ストライプ数 (unsigned int)
+ */
+Cache::Cache(Store& st, std::int64_t q_ns, std::size_t n_max, unsigned int n_stripe)
+    : st(st), q_ns(q_ns), n_stripe(n_stripe), n_set(0) {
+  unsigned int i;
+
+  try {
+    if (q_ns <= 0 || n_stripe == 0) {
+      std::cout << "[ERROR] Invalid cache parameters!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    n_set = (n_max + n_stripe * kCacheWay - 1) / (n_stripe * kCacheWay);
+    if (n_set == 0) n_set = 1;
+    stripe.reset(new Stripe[n_stripe]);
+    for (i = 0; i < n_stripe; ++i) {
+      stripe[i].ent.reset(new Entry[n_set * kCacheWay]());
+      stripe[i].clk.reset(new unsigned char[n_set]());
+      stripe[i].n_hit.store(0);
+      stripe[i].n_miss.store(0);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       取得
+ *              * 時刻を量子化の幅で切り捨て、キャッシュに無ければその時刻で
+ *                計算して登録する。（計算中はロックを保持しない）
+ *              * 複写先の指定外の値は変更しない。
+ *
+ * @param[in]   UT1 (timespec)
+ * @param[in]   値の指定 (uint64_t; 1 << Val)
+ * @param[ref]  計算結果 (Result)
+ * @return      true（取得）| false（対象年の係数が無い）
+ */
+bool Cache::get(struct timespec ut1, std::uint64_t mask, Result& res) {
+  std::int64_t ns;         // UT1（ナノ秒）
+  std::int64_t q;          // 量子化した時刻
+  std::uint64_t h;         // ハッシュ値
+  std::uint64_t gen;       // 係数の世代
+  unsigned int year;       // 西暦年
+  unsigned int w;          // loop index
+  struct timespec tq;      // 量子化した時刻（timespec）
+  Result r;                // 計算結果（ミス時）
+
+  try {
+    ns = static_cast<std::int64_t>(ut1.tv_sec) * kNsecSec + ut1.tv_nsec;
+    q  = ns / q_ns - (ns % q_ns < 0 ? 1 : 0);
+    ns = q * q_ns;
+    tq.tv_sec  = ns / kNsecSec - (ns % kNsecSec < 0 ? 1 : 0);
+    tq.tv_nsec = ns - static_cast<std::int64_t>(tq.tv_sec) * kNsecSec;
+    year = ts2dt(tq).year;
+
+    Store::Reader rd(st);
+    gen = rd.get().gen;
+    h = calc_hash(static_cast<std::uint64_t>(q));
+    Stripe& s = stripe[h % n_stripe];
+    std::size_t i_set = (h / n_stripe) % n_set;
+    Entry* e = &s.ent[i_set * kCacheWay];
+
+    // 検索
+    {
+      std::lock_guard<std::mutex> lk(s.mtx);
+      for (w = 0; w < kCacheWay; ++w) {
+        if (e[w].gen == gen && e[w].q == q && e[w].year == year) {
+          copy_val(e[w].res, mask, res);
+          s.n_hit.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+      s.n_miss.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 計算
+    const Param* p = rd.find(year);
+    if (p == nullptr) return false;
+    EphJcg o_e(*p);
+    o_e.calc(tq, r);
+
+    // 登録（空きがあれば空き、無ければ巡回で置き換え）
+    {
+      std::lock_guard<std::mutex> lk(s.mtx);
+      for (w = 0; w < kCacheWay; ++w) {
+        if (e[w].gen != gen) break;
+      }
+      if (w == kCacheWay) {
+        w = s.clk[i_set];
+        s.clk[i_set] = (w + 1) % kCacheWay;
+      }
+      e[w].q    = q;
+      e[w].gen  = gen;
+      e[w].year = year;
+      e[w].res  = r;
+    }
+    copy_val(r, mask, res);
+  } catch (...) {
+    throw;
+  }
+
+  return true;
+}
+
+/*
+ * @brief      取得: ヒット数
+ *
+ * @param[in]  <none>
+ * @return     ヒット数 (uint64_t)
+ */
+std::uint64_t Cache::get_n_hit() const {
+  std::uint64_t n = 0;
+  unsigned int i;
+
+  for (i = 0; i < n_stripe; ++i) n += stripe[i].n_hit.load(std::memory_order_relaxed);
+  return n;
+}
+
+/*
+ * @brief      取得: ミス数
+ *
+ * @param[in]  <none>
+ * @return     ミス数 (uint64_t)
+ */
+std::uint64_t Cache::get_n_miss() const {
+  std::uint64_t n = 0;
+  unsigned int i;
+
+  for (i = 0; i < n_stripe; ++i) n += stripe[i].n_miss.load(std::memory_order_relaxed);
+  return n;
+}
+
+/*
+ * @brief      容量（エントリ数）
+ *
+ * @param[in]  <none>
+ * @return     容量 (size_t)
+ */
+std::size_t Cache::capacity() const {
+  return n_set * kCacheWay * n_stripe;
+}
+
+/*
+ * @brief      全エントリの破棄
+ *             * ヒット数・ミス数は保持する。
+ *
+ * @param[in]  <none>
+ * @return     <none>
+ */
+void Cache::clear() {
+  unsigned int i;
+  std::size_t j;
+
+  for (i = 0; i < n_stripe; ++i) {
+    std::lock_guard<std::mutex> lk(stripe[i].mtx);
+    for (j = 0; j < n_set * kCacheWay; ++j) stripe[i].ent[j].gen = 0;
+  }
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,68 @@
+#ifndef EPHEMERIS_JCG_CACHE_HPP_
+#define EPHEMERIS_JCG_CACHE_HPP_
+
+#include "result.hpp"
+#include "store.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr unsigned int  kCacheWay = 4;  // 組あたりのエントリ数
+static constexpr std::uint64_t kMaskAll  = (1ULL << kNumVal) - 1;  // 値の指定: 全て
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 計算結果のキャッシュ
+// * キーは（西暦年, 量子化した時刻, 係数の世代）。
+//   時刻は量子化の幅で切り捨て、その時刻で計算した値を返す。
+// * 1回の計算で全ての値が求まるため、値の指定（ビットマスク; 1 << Val）は
+//   キーに含めず、取り出す値の選択にのみ用いる。（同一時刻は指定に依らず共用）
+// * 容量は固定。ストライプ（ロック単位）毎の4ウェイ・セットアソシアティブ表とし、
+//   組内は巡回で置き換える。
+// * 係数の再読み込み（Store）後は世代が変わるため、旧エントリは参照されない。
+class Cache {
+  struct Entry {
+    std::int64_t  q;     // 量子化した時刻（1970-01-01 00:00:00 からの幅の数）
+    std::uint64_t gen;   // 係数の世代（0: 空き）
+    unsigned int  year;  // 西暦年
+    Result        res;   // 計算結果
+  };
+  struct alignas(64) Stripe {
+    std::mutex mtx;                      // 排他
+    std::unique_ptr<Entry[]> ent;        // エントリ（組数 * kCacheWay）
+    std::unique_ptr<unsigned char[]> clk;  // 組毎の次の置き換え位置
+    std::atomic<std::uint64_t> n_hit;    // ヒット数
+    std::atomic<std::uint64_t> n_miss;   // ミス数
+  };
+
+  Store& st;                           // 係数・ΔT の保持
+  std::int64_t q_ns;                   // 量子化の幅（ナノ秒）
+  unsigned int n_stripe;               // ストライプ数
+  std::size_t n_set;                   // ストライプあたりの組数
+  std::unique_ptr<Stripe[]> stripe;    // ストライプ
+
+public:
+  Cache(Store&, std::int64_t, std::size_t, unsigned int = 64);  // コンストラクタ
+  Cache(const Cache&) = delete;
+  Cache& operator=(const Cache&) = delete;
+  bool get(struct timespec, std::uint64_t, Result&);  // 取得（ミスの場合は計算）
+  std::uint64_t get_n_hit() const;     // 取得: ヒット数
+  std::uint64_t get_n_miss() const;    // 取得: ミス数
+  std::size_t capacity() const;        // 容量（エントリ数）
+  void clear();                        // 全エントリの破棄（カウンタは保持）
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
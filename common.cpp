@@ -7,10 +7,332 @@ namespace ephemeris_jcg {
 // -------------------------------------
 static constexpr unsigned int kJstOffset = 9;     // JST - UTC (hours)
 static constexpr unsigned int kSecInHour = 3600;  // Seconds in an hour
+static constexpr long long    kSecInDay  = 86400; // Seconds in a day
+static constexpr long long    kDaysEra   = 146097;  // Days in 400 years
+static constexpr long long    kDaysEpoch = 719468;  // 0000-03-01 -> 1970-01-01
+static constexpr std::size_t  kUt1Digits = 23;      // UT1 文字列の最大桁数
 
 // -------------------------------------
 //   Functions
 // -------------------------------------
+/*
+ * @brief      年月日 -> 通し日数（1970-01-01 を 0 とする）変換
+ *             * 3月始まりの年で閏日を年末に寄せ、整数演算のみで計算する。
+ *               （TZ・ロケールに依存せず、ロックも取らない）
+ *
+ * @param[in]  西暦年 (int)
+ * @param[in]  月 (unsigned int)
+ * @param[in]  日 (unsigned int; 1 - 31)
+ * @return     通し日数 (long long)
+ */
+long long days_from_civil(int y, unsigned int m, unsigned int d) {
+  long long    era;
+  unsigned int yoe;
+  unsigned int doy;
+  unsigned int doe;
+
+  y  -= m <= 2;
+  era = (y >= 0 ? y : y - 399) / 400;
+  yoe = static_cast<unsigned int>(y - era * 400);
+  doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  return era * kDaysEra + static_cast<long long>(doe) - kDaysEpoch;
+}
+
+/*
+ * @brief       通し日数（1970-01-01 を 0 とする） -> 年月日 変換
+ *
+ * @param[in]   通し日数 (long long)
+ * @param[ref]  西暦年 (int)
+ * @param[ref]  月 (unsigned int)
+ * @param[ref]  日 (unsigned int)
+ * @return      <none>
+ */
+void civil_from_days(long long z, int& y, unsigned int& m, unsigned int& d) {
+  long long    era;
+  unsigned int doe;
+  unsigned int yoe;
+  unsigned int doy;
+  unsigned int mp;
+
+  z  += kDaysEpoch;
+  era = (z >= 0 ? z : z - (kDaysEra - 1)) / kDaysEra;
+  doe = static_cast<unsigned int>(z - era * kDaysEra);
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  mp  = (5 * doy + 2) / 153;
+  d   = doy - (153 * mp + 2) / 5 + 1;
+  m   = mp < 10 ? mp + 3 : mp - 9;
+  y   = static_cast<int>(yoe + era * 400) + (m <= 2);
+}
+
+/*
+ * @brief      timespec -> 日時 変換
+ *             * timespec は UT1 の 1970-01-01 00:00:00 からの経過秒とみなす。
+ *               （localtime_r の代替。 TZ に依存しない）
+ *
+ * @param[in]  日時 (timespec)
+ * @return     日時 (DateTime)
+ */
+DateTime ts2dt(struct timespec ts) {
+  DateTime  dt;
+  long long days;
+  long long sod;
+
+  days = ts.tv_sec / kSecInDay;
+  sod  = ts.tv_sec % kSecInDay;
+  if (sod < 0) {
+    sod  += kSecInDay;
+    days -= 1;
+  }
+  civil_from_days(days, dt.year, dt.month, dt.day);
+  dt.hour = static_cast<unsigned int>(sod / kSecInHour);
+  dt.min  = static_cast<unsigned int>(sod % kSecInHour / 60);
+  dt.sec  = static_cast<unsigned int>(sod % 60);
+  dt.nsec = static_cast<unsigned int>(ts.tv_nsec);
+
+  return dt;
+}
+
+/*
+ * @brief      日時 -> timespec 変換
+ *             * mktime の代替。 TZ に依存しない。
+ *
+ * @param[in]  日時 (DateTime)
+ * @return     日時 (timespec)
+ */
+struct timespec dt2ts(const DateTime& dt) {
+  struct timespec ts;
+
+  ts.tv_sec  = days_from_civil(dt.year, dt.month, dt.day) * kSecInDay
+             + dt.hour * kSecInHour + dt.min * 60 + dt.sec;
+  ts.tv_nsec = dt.nsec;
+
+  return ts;
+}
+
+/*
+ * @brief       timespec -> 西暦年・通日 T・日の端数 F 変換（一括）
+ *              * 分岐・関数呼び出しを含まない整数演算のみのループとし、
+ *                大量の時刻を一括変換する際にベクトル化されるようにする。
+ *              * F は EphJcg::calc_f と同じ式（時・分・秒・ナノ秒の和）で求め、
+ *                1時刻ずつ計算した場合とビット単位で一致させる。
+ *
+ * @param[in]   日時配列 (timespec*)
+ * @param[in]   件数 (size_t)
+ * @param[out]  西暦年配列 (int*)
+ * @param[out]  通日 T 配列（1月0日を第0日とする） (unsigned int*)
+ * @param[out]  UT1 の日の端数配列 (double*)
+ * @return      <none>
+ */
+void ts2tf(const struct timespec* ts, std::size_t n,
+           int* year, unsigned int* t, double* f) {
+  std::size_t i;
+
+  for (i = 0; i < n; ++i) {
+    long long    sec  = ts[i].tv_sec;
+    long long    days = (sec >= 0 ? sec : sec - (kSecInDay - 1)) / kSecInDay;
+    long long    sod  = sec - days * kSecInDay;
+    long long    z    = days + kDaysEpoch;
+    long long    era  = (z >= 0 ? z : z - (kDaysEra - 1)) / kDaysEra;
+    unsigned int doe  = static_cast<unsigned int>(z - era * kDaysEra);
+    unsigned int yoe  = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned int doy  = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int          y    = static_cast<int>(yoe + era * 400);
+    // 3月始まりの通日 doy を1月始まりの通日 T に変換
+    // （1月・2月は翌年として扱い、3月以降は西暦年 y の2月の日数を加える）
+    unsigned int leap = (y % 4 == 0) & ((y % 100 != 0) | (y % 400 == 0));
+    unsigned int jf   = doy >= 306;  // 1月・2月
+    unsigned int hh   = static_cast<unsigned int>(sod) / kSecInHour;  // 時
+    unsigned int mm   = static_cast<unsigned int>(sod) / 60 % 60;     // 分
+    unsigned int ss   = static_cast<unsigned int>(sod) % 60;          // 秒
+    year[i] = y + static_cast<int>(jf);
+    t[i]    = jf ? doy - 305 : doy + 60 + leap;
+    f[i]    = hh / 24.0 + mm / 1440.0 + ss / 86400.0
+            + static_cast<unsigned int>(ts[i].tv_nsec) / (86400.0 * 1.0e9);
+  }
+}
+
+/*
+ * @brief      判定: 年月日
+ *             * 通日へ変換して戻し、同じ年月日となるか（月の日数を超えないか）で
+ *               判定する。
+ *
+ * @param[in]  年 (int)
+ * @param[in]  月 (unsigned int)
+ * @param[in]  日 (unsigned int)
+ * @return     true: 有効, false: 無効
+ */
+static bool is_valid_date(int y, unsigned int m, unsigned int d) {
+  int          y2;
+  unsigned int m2;
+  unsigned int d2;
+
+  if (m < 1 || 12 < m || d < 1 || 31 < d) return false;
+  civil_from_days(days_from_civil(y, m, d), y2, m2, d2);
+
+  return y2 == y && m2 == m && d2 == d;
+}
+
+/*
+ * @brief       UT1 文字列 -> timespec 変換
+ *              * 書式: 最大23桁の数字（先頭から、西暦年(4), 月(2), 日(2),
+ *                      時(2), 分(2), 秒(2), 1秒未満(9)）
+ *              * 先頭から部分的に指定した場合、月・日は 1 、それ以外は 0 とみなす。
+ *              * 存在しない日付（2020-02-30 等）は書式エラーとする。
+ *              * std::get_time, mktime, std::stod を使用せず、整数演算のみで変換する。
+ *
+ * @param[in]   文字列 (const char*)
+ * @param[in]   文字列長 (size_t)
+ * @param[ref]  UT1 (timespec)
+ * @return      true: 成功, false: 書式エラー
+ */
+bool parse_ut1(const char* s, std::size_t n, struct timespec& ts) {
+  static constexpr unsigned int kPos[7] = {0, 4, 6, 8, 10, 12, 14};  // 開始位置
+  static constexpr unsigned int kLen[7] = {4, 2, 2, 2,  2,  2,  9};  // 桁数
+  unsigned int v[7] = {0, 1, 1, 0, 0, 0, 0};  // 年, 月, 日, 時, 分, 秒, ナノ秒
+  unsigned int i;
+  unsigned int j;
+  DateTime dt;
+
+  if (n < kLen[0] || n > kUt1Digits) return false;
+  for (i = 0; i < 7 && kPos[i] < n; ++i) {
+    v[i] = 0;
+    for (j = kPos[i]; j < kPos[i] + kLen[i]; ++j) {
+      if (j < n) {
+        if (s[j] < '0' || '9' < s[j]) return false;
+        v[i] = v[i] * 10 + (s[j] - '0');
+      } else if (i == 6) {
+        v[i] *= 10;  // 1秒未満は右側を 0 で埋める
+      }
+    }
+  }
+  if (!is_valid_date(static_cast<int>(v[0]), v[1], v[2]) ||
+      v[3] > 23 || v[4] > 59 || v[5] > 60) return false;
+  dt.year  = static_cast<int>(v[0]);
+  dt.month = v[1];
+  dt.day   = v[2];
+  dt.hour  = v[3];
+  dt.min   = v[4];
+  dt.sec   = v[5];
+  dt.nsec  = v[6];
+  ts = dt2ts(dt);
+
+  return true;
+}
+
+/*
+ * @brief       数字の読み取り（固定桁数）
+ *
+ * @param[in]   文字列 (const char*)
+ * @param[in]   桁数 (unsigned int)
+ * @param[ref]  値 (unsigned int)
+ * @return      true: 成功, false: 数字以外を含む
+ */
+static bool read_digits(const char* s, unsigned int n, unsigned int& v) {
+  unsigned int i;
+
+  v = 0;
+  for (i = 0; i < n; ++i) {
+    if (s[i] < '0' || '9' < s[i]) return false;
+    v = v * 10 + (s[i] - '0');
+  }
+
+  return true;
+}
+
+/*
+ * @brief       ISO-8601 文字列 -> timespec 変換
+ *              * 書式: YYYY-MM-DD[(T| )hh:mm[:ss[.f...]]][Z|(+|-)hh[:]mm]
+ *                （1秒未満は9桁まで。時差を指定した場合は UT に換算する）
+ *              * 存在しない日付（2020-02-30 等）は書式エラーとする。
+ *              * 整数演算のみで変換する。
+ *
+ * @param[in]   文字列 (const char*)
+ * @param[in]   文字列長 (size_t)
+ * @param[ref]  UT1 (timespec)
+ * @return      true: 成功, false: 書式エラー
+ */
+bool parse_iso8601(const char* s, std::size_t n, struct timespec& ts) {
+  unsigned int v[6] = {0, 1, 1, 0, 0, 0};  // 年, 月, 日, 時, 分, 秒
+  unsigned int ns = 0;   // ナノ秒
+  unsigned int k;        // 1秒未満の桁数
+  unsigned int oh;       // 時差（時）
+  unsigned int om;       // 時差（分）
+  long long    off = 0;  // 時差（秒）
+  std::size_t  p;        // 読み取り位置
+  DateTime     dt;
+
+  if (n < 10 || !read_digits(s, 4, v[0]) || s[4] != '-' ||
+      !read_digits(s + 5, 2, v[1]) || s[7] != '-' ||
+      !read_digits(s + 8, 2, v[2])) return false;
+  p = 10;
+  if (p < n && (s[p] == 'T' || s[p] == ' ')) {
+    if (n < p + 6 || !read_digits(s + p + 1, 2, v[3]) || s[p + 3] != ':' ||
+        !read_digits(s + p + 4, 2, v[4])) return false;
+    p += 6;
+    if (p < n && s[p] == ':') {
+      if (n < p + 3 || !read_digits(s + p + 1, 2, v[5])) return false;
+      p += 3;
+      if (p < n && (s[p] == '.' || s[p] == ',')) {
+        for (++p, k = 0; p < n && '0' <= s[p] && s[p] <= '9'; ++p, ++k) {
+          if (k < 9) ns = ns * 10 + (s[p] - '0');
+        }
+        if (k == 0) return false;
+        for (; k < 9; ++k) ns *= 10;
+      }
+    }
+    if (p < n && s[p] == 'Z') {
+      ++p;
+    } else if (p < n && (s[p] == '+' || s[p] == '-')) {
+      if (n < p + 3 || !read_digits(s + p + 1, 2, oh)) return false;
+      om = 0;
+      k  = 3;
+      if (n >= p + 6 && s[p + 3] == ':') {
+        if (!read_digits(s + p + 4, 2, om)) return false;
+        k = 6;
+      } else if (n >= p + 5) {
+        if (!read_digits(s + p + 3, 2, om)) return false;
+        k = 5;
+      }
+      if (oh > 23 || om > 59) return false;
+      off = (oh * 60LL + om) * 60;
+      if (s[p] == '-') off = -off;
+      p += k;
+    }
+  }
+  if (p != n) return false;
+  if (!is_valid_date(static_cast<int>(v[0]), v[1], v[2]) ||
+      v[3] > 23 || v[4] > 59 || v[5] > 60) return false;
+  dt.year  = static_cast<int>(v[0]);
+  dt.month = v[1];
+  dt.day   = v[2];
+  dt.hour  = v[3];
+  dt.min   = v[4];
+  dt.sec   = v[5];
+  dt.nsec  = ns;
+  ts = dt2ts(dt);
+  ts.tv_sec -= off;
+
+  return true;
+}
+
+/*
+ * @brief       時刻文字列 -> timespec 変換
+ *              * 5文字目が '-' なら ISO-8601（parse_iso8601）、
+ *                それ以外は数字のみの書式（parse_ut1）とみなす。
+ *
+ * @param[in]   文字列 (const char*)
+ * @param[in]   文字列長 (size_t)
+ * @param[ref]  UT1 (timespec)
+ * @return      true: 成功, false: 書式エラー
+ */
+bool parse_time(const char* s, std::size_t n, struct timespec& ts) {
+  if (n > 4 && s[4] == '-') return parse_iso8601(s, n, ts);
+  return parse_ut1(s, n, ts);
+}
+
 /*
  * @brief      JST -> UTC 変換
  *
@@ -37,19 +359,19 @@ struct timespec jst2utc(struct timespec ts_jst) {
  * @return     日時文字列 (string)
  */
 std::string gen_time_str(struct timespec ts) {
-  struct tm t;
+  DateTime dt;
   std::stringstream ss;
   std::string str_tm;
 
   try {
-    localtime_r(&ts.tv_sec, &t);
+    dt = ts2dt(ts);
     ss << std::setfill('0')
-       << std::setw(4) << t.tm_year + 1900 << "-"
-       << std::setw(2) << t.tm_mon + 1     << "-"
-       << std::setw(2) << t.tm_mday        << " "
-       << std::setw(2) << t.tm_hour        << ":"
-       << std::setw(2) << t.tm_min         << ":"
-       << std::setw(2) << t.tm_sec         << "."
+       << std::setw(4) << dt.year  << "-"
+       << std::setw(2) << dt.month << "-"
+       << std::setw(2) << dt.day   << " "
+       << std::setw(2) << dt.hour  << ":"
+       << std::setw(2) << dt.min   << ":"
+       << std::setw(2) << dt.sec   << "."
        << std::setw(3) << ts.tv_nsec / 1000000;
     return ss.str();
   } catch (...) {
@@ -1,6 +1,7 @@
 #ifndef EPHEMERIS_JCG_COMMON_HPP_
 #define EPHEMERIS_JCG_COMMON_HPP_
 
+#include <cstddef>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -8,9 +9,30 @@
 
 namespace ephemeris_jcg {
 
+// -------------------------------------
+//   Structs
+// -------------------------------------
+struct DateTime {
+  int          year;   // 西暦年
+  unsigned int month;  // 月
+  unsigned int day;    // 日
+  unsigned int hour;   // 時
+  unsigned int min;    // 分
+  unsigned int sec;    // 秒
+  unsigned int nsec;   // ナノ秒
+};
+
 // -------------------------------------
 //   Functions
 // -------------------------------------
+long long days_from_civil(int, unsigned int, unsigned int);
+void civil_from_days(long long, int&, unsigned int&, unsigned int&);
+DateTime ts2dt(struct timespec);
+struct timespec dt2ts(const DateTime&);
+void ts2tf(const struct timespec*, std::size_t, int*, unsigned int*, double*);
+bool parse_ut1(const char*, std::size_t, struct timespec&);
+bool parse_iso8601(const char*, std::size_t, struct timespec&);
+bool parse_time(const char*, std::size_t, struct timespec&);
 struct timespec jst2utc(struct timespec);
 std::string gen_time_str(struct timespec);
 std::string hour2hms(double);
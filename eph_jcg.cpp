@@ -7,9 +7,6 @@ static constexpr double       kHourDay = 24.0;     // Hours   in a day
 static constexpr double       kMinDay  = 1440.0;   // Minutes in a day
 static constexpr double       kSecDay  = 86400.0;  // Seconds in a day
 static constexpr double       kPi      = atan(1.0) * 4;  // PI
-static constexpr unsigned int kSizeS   = 18;      // 係数の数: 太陽, etc.
-static constexpr unsigned int kSizeR   = 8;       // 係数の数: R, 黄道傾角
-static constexpr unsigned int kSizeM   = 30;      // 係数の数: 月
 static constexpr double       kS0Sun   = 16.02;   // SD 計算用係数: （太陽; ′）
 static constexpr double       kS0Vns   = 8.3;     // SD 計算用係数: （金星; ″）
 static constexpr double       kS0Mrs   = 4.7;     // SD 計算用係数: （火星; ″）
@@ -18,26 +15,179 @@ static constexpr double       kS0JptE  = 98.4;    // SD 計算用係数: （木
 static constexpr double       kS0SatP  = 73.8;    // SD 計算用係数: （土星・極半径; ″）
 static constexpr double       kS0SatE  = 82.7;    // SD 計算用係数: （土星・赤道半径; ″）
 static constexpr double       kS0Mon   = 0.2725;  // SD 計算用係数: （月）
+static constexpr std::size_t  kTfBlk   = 64;      // 一括変換する時刻数（calc: 多数の時刻）
 
 /*
  * @brief  コンストラクタ
+ *         * 対象年の係数を読み込み、計算する。
+ *         * 許容誤差を指定した場合は、読み込み後に係数を打ち切る。（Trunc）
  *
  * @param[in]  UT1 (timespec)
+ * @param[in]  許容誤差 (double; ″; 0 以下なら打ち切らない)
  */
-EphJcg::EphJcg(struct timespec ts) {
-  this->ts = ts;  // UT1
-  get_ut1();                      // 取得: UT1（年月日時分秒）
+EphJcg::EphJcg(struct timespec ts, double tol) : i_seg(), trc() {
   File o_f;
-  dlt_t = o_f.get_delta_t(year);  // 取得: ΔT
-  if (dlt_t == 0) {
-    std::cout << "[ERROR] " << year << " is out of range!" << std::endl;
-    std::exit(EXIT_FAILURE);
+
+  this->ts = ts;  // UT1
+  get_ut1();                  // 取得: UT1（年月日時分秒）
+  prm_own.reset(new Param);
+  o_f.get_param(year, *prm_own);  // 取得: ΔT, 係数
+  if (tol > 0.0) Trunc(tol).calc(*prm_own, trc);  // 打ち切り
+  prm = prm_own.get();
+  calc(ts);                   // 計算
+}
+
+/*
+ * @brief  コンストラクタ
+ *         * 読み込み済みの係数を使用する。（計算は calc で行う）
+ *         * 係数は複写せず参照のみ保持する。
+ *
+ * @param[in]  係数 (Param)
+ */
+EphJcg::EphJcg(const Param& prm) : prm(&prm), i_seg(), trc() {}
+
+/*
+ * @brief      計算
+ *             * 係数の読み込み後は、ヒープ領域の確保を一切行わない。
+ *               （同一インスタンスで時刻を変えて繰り返し計算可能）
+ *
+ * @param[in]  UT1 (timespec)
+ * @return     <none>
+ */
+void EphJcg::calc(struct timespec ts) {
+  try {
+    calc(ts, *this);
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算
+ *              * 係数の読み込み後は、ヒープ領域の確保を一切行わない。
+ *              * 計算結果は呼び出し元が用意した領域に格納する。
+ *
+ * @param[in]   UT1 (timespec)
+ * @param[ref]  計算結果 (Result)
+ * @return      <none>
+ */
+void EphJcg::calc(struct timespec ts, Result& res) {
+  try {
+    this->ts = ts;  // UT1
+    get_ut1();      // 取得: UT1（年月日時分秒）
+    if (year != prm->year) {
+      std::cout << "[ERROR] " << year << " is not "
+                << prm->year << "!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    calc_t();       // 計算: 通日 T
+    calc_f();       // 計算: 世界時 UT（時・分・秒） の日の端数
+    calc_tm();      // 計算: 計算用時刻引数
+    calc_seg();     // 計算: 適用期間
+    calc_val(res);  // 計算: 各種
+  } catch (...) {
+    throw;
   }
-  calc_t();                // 計算: 通日 T
-  calc_f();                // 計算: 世界時 UT（時・分・秒） の日の端数
-  calc_tm();               // 計算: 計算用時刻引数
-  o_f.get_param(year, tm, tm_r, ab, param);  // 取得: 係数
-  calc_val();              // 計算: 各種
+}
+
+/*
+ * @brief       計算（変換済みの時刻）
+ *              * ts2tf で一括変換した西暦年・通日 T・日の端数 F を使用する。
+ *                （UT1 の年月日時分秒への変換を省く; 結果は calc(ts, res) と同一）
+ *
+ * @param[in]   西暦年 (int)
+ * @param[in]   通日 T (unsigned int)
+ * @param[in]   UT1 の日の端数 F (double)
+ * @param[ref]  計算結果 (Result)
+ * @return      <none>
+ */
+void EphJcg::calc(int year, unsigned int t, double f, Result& res) {
+  try {
+    if (year != static_cast<int>(prm->year)) {
+      std::cout << "[ERROR] " << year << " is not "
+                << prm->year << "!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    this->year = year;
+    this->t    = t;
+    this->f    = f;
+    calc_tm();      // 計算: 計算用時刻引数
+    calc_seg();     // 計算: 適用期間
+    calc_val(res);  // 計算: 各種
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算（多数の時刻）
+ *              * kTfBlk 件毎に ts2tf で一括変換してから計算する。
+ *                （変換用の領域はスタック上; ヒープ領域の確保は行わない）
+ *              * 全ての時刻が係数と同じ年であること。
+ *
+ * @param[in]   UT1 配列 (const timespec*)
+ * @param[in]   件数 (size_t)
+ * @param[out]  計算結果配列 (Result*; 件数分)
+ * @return      <none>
+ */
+void EphJcg::calc(const struct timespec* ts, std::size_t n, Result* res) {
+  int          y[kTfBlk];  // 西暦年
+  unsigned int t[kTfBlk];  // 通日 T
+  double       f[kTfBlk];  // UT1 の日の端数 F
+  std::size_t  i0;
+  std::size_t  m;
+  std::size_t  i;
+
+  try {
+    for (i0 = 0; i0 < n; i0 += kTfBlk) {
+      m = std::min(kTfBlk, n - i0);
+      ts2tf(ts + i0, m, y, t, f);
+      for (i = 0; i < m; ++i) calc(y[i], t[i], f[i], res[i0 + i]);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief   取得: 係数の西暦年
+ *
+ * @param   <none>
+ * @return  西暦年 (unsigned int)
+ */
+unsigned int EphJcg::get_year() const {
+  return prm->year;
+}
+
+/*
+ * @brief   取得: 計算用時刻引数（直近の calc の時刻）
+ *
+ * @param   <none>
+ * @return  計算用時刻引数 (double)
+ */
+double EphJcg::get_tm() const {
+  return tm;
+}
+
+/*
+ * @brief   取得: UT1 の日の端数（直近の calc の時刻）
+ *
+ * @param   <none>
+ * @return  UT1 の日の端数 (double)
+ */
+double EphJcg::get_f() const {
+  return f;
+}
+
+/*
+ * @brief   取得: 打ち切りの結果
+ *
+ * @param   <none>
+ * @return  打ち切りの結果 (TruncStat)
+ *          （打ち切っていない場合は全て 0）
+ */
+const TruncStat& EphJcg::get_trunc() const {
+  return trc;
 }
 
 // -------------------------------------
@@ -51,17 +201,17 @@ EphJcg::EphJcg(struct timespec ts) {
  * @return  <none>
  */
 void EphJcg::get_ut1() {
-  struct tm t;
+  DateTime dt;
 
   try {
-    localtime_r(&ts.tv_sec, &t);
-    year  = t.tm_year + 1900;
-    month = t.tm_mon + 1;
-    day   = t.tm_mday;
-    hour  = t.tm_hour;
-    min   = t.tm_min;
-    sec   = t.tm_sec;
-    nsec  = ts.tv_nsec;
+    dt    = ts2dt(ts);
+    year  = dt.year;
+    month = dt.month;
+    day   = dt.day;
+    hour  = dt.hour;
+    min   = dt.min;
+    sec   = dt.sec;
+    nsec  = dt.nsec;
   } catch (...) {
     throw;
   }
@@ -69,22 +219,14 @@ void EphJcg::get_ut1() {
 
 /*
  * @brief   計算: 通日 T
+ *          * 当日と1月1日の通し日数の差から求める。（整数演算のみ）
  *
  * @param   <none>
  * @return  <none>
  */
 void EphJcg::calc_t() {
-  unsigned int p;
-  unsigned int q;
-  unsigned int y;
-  unsigned int s;
-
   try {
-    p = month - 1;
-    q = static_cast<int>((month + 7) / 10.0);
-    y = static_cast<int>((year / 4.0) - static_cast<int>(year / 4.0) + 0.77);
-    s = static_cast<int>(p * 0.55 - 0.33);
-    t = 30 * p + q * (s - y) + p * (1 - q) + day;
+    t = days_from_civil(year, month, day) - days_from_civil(year, 1, 1) + 1;
   } catch (...) {
     throw;
   }
@@ -116,54 +258,102 @@ void EphJcg::calc_f() {
 void EphJcg::calc_tm() {
   try {
     tm_r = t + f;
-    tm   = tm_r + dlt_t / kSecDay;
+    tm   = tm_r + prm->dlt_t / kSecDay;
   } catch (...) {
     throw;
   }
 }
 
 /*
- * @brief   計算: 各種
+ * @brief   計算: 適用期間
+ *          * 区分毎に、時刻引数を含む最初の適用期間を選択する。
+ *            （R, 黄道傾角は R 計算用の時刻引数で選択する）
+ *          * 直前の適用期間が引き続き最初の適用期間であれば、検索を省く。
+ *            （適用期間は時刻順で、隣接する期間は重なる場合がある）
+ *          * 年末の ΔT 秒分など、最後の適用期間の終了を超える場合は最後の適用期間とする。
  *
  * @param   <none>
  * @return  <none>
  */
-void EphJcg::calc_val() {
+void EphJcg::calc_seg() {
+  unsigned int g;
+  unsigned int i;
+  double       v;
+
   try {
-    sun_ra   = calc_cmn("SUN_RA",   tm);        // R.A. (太陽) (h)
-    sun_dec  = calc_cmn("SUN_DEC",  tm);        // Dec. (太陽) (°)
-    sun_dist = calc_cmn("SUN_DIST", tm);        // Dist.(太陽) (au)
-    vns_ra   = calc_cmn("VNS_RA",   tm);        // R.A. (金星) (h)
-    vns_dec  = calc_cmn("VNS_DEC",  tm);        // Dec. (金星) (°)
-    vns_dist = calc_cmn("VNS_DIST", tm);        // Dist.(金星) (au)
-    mrs_ra   = calc_cmn("MRS_RA",   tm);        // R.A. (火星) (h)
-    mrs_dec  = calc_cmn("MRS_DEC",  tm);        // Dec. (火星) (°)
-    mrs_dist = calc_cmn("MRS_DIST", tm);        // Dist.(火星) (au)
-    jpt_ra   = calc_cmn("JPT_RA",   tm);        // R.A. (木星) (h)
-    jpt_dec  = calc_cmn("JPT_DEC",  tm);        // Dec. (木星) (°)
-    jpt_dist = calc_cmn("JPT_DIST", tm);        // Dist.(木星) (au)
-    sat_ra   = calc_cmn("SAT_RA",   tm);        // R.A. (土星) (h)
-    sat_dec  = calc_cmn("SAT_DEC",  tm);        // Dec. (土星) (°)
-    sat_dist = calc_cmn("SAT_DIST", tm);        // Dist.(土星) (au)
-    mon_ra   = calc_cmn("MON_RA",   tm);        // R.A. (月) (h)
-    mon_dec  = calc_cmn("MON_DEC",  tm);        // Dec. (月) (°)
-    mon_hp   = calc_cmn("MON_HP",   tm);        // H.P. (月) (°)
-    r        = calc_cmn("R",      tm_r);        // R
-    eps      = calc_cmn("EPS",      tm);        // ε
-    sun_hg   = calc_hg(sun_ra);                 // グリニッジ時角（太陽）
-    vns_hg   = calc_hg(vns_ra);                 // グリニッジ時角（金星）
-    mrs_hg   = calc_hg(mrs_ra);                 // グリニッジ時角（火星）
-    jpt_hg   = calc_hg(jpt_ra);                 // グリニッジ時角（木星）
-    sat_hg   = calc_hg(sat_ra);                 // グリニッジ時角（土星）
-    mon_hg   = calc_hg(mon_ra);                 // グリニッジ時角（月）
-    sun_sd   = calc_sd_sun();                   // 視半径（太陽）
-    vns_sd   = calc_sd_etc(kS0Vns,  vns_dist);  // 視半径（金星）
-    mrs_sd   = calc_sd_etc(kS0Mrs,  mrs_dist);  // 視半径（火星）
-    jpt_sd_p = calc_sd_etc(kS0JptP, jpt_dist);  // 視半径（木星）
-    jpt_sd_e = calc_sd_etc(kS0JptE, jpt_dist);  // 視半径（木星）
-    sat_sd_p = calc_sd_etc(kS0SatP, sat_dist);  // 視半径（土星）
-    sat_sd_e = calc_sd_etc(kS0SatE, sat_dist);  // 視半径（土星）
-    mon_sd   = calc_sd_mon();                   // 視半径（月）
+    for (g = 0; g < kNumGrp; ++g) {
+      const GrpParam& gp = prm->grp[g];
+      v = (g == kGrpR) ? tm_r : tm;
+      i = i_seg[g];
+      if (i < gp.n_seg && gp.seg[i].a <= v && v < gp.seg[i].b &&
+          (i == 0 || gp.seg[i - 1].b <= v)) continue;
+      i_seg[g] = 0;
+      for (i = 0; i < gp.n_seg; ++i) {
+        if (gp.seg[i].a <= v && v < gp.seg[i].b) break;
+      }
+      if (i < gp.n_seg) {
+        i_seg[g] = i;
+      } else if (gp.n_seg > 0 && gp.seg[gp.n_seg - 1].b <= v) {
+        i_seg[g] = gp.n_seg - 1;
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算: 各種
+ *              * 太陽・惑星・月は天体毎に一括で計算する。（calc_body）
+ *              * R, 黄道傾角は時刻引数が異なるため、値毎に計算する。（calc_cmn）
+ *
+ * @param[ref]  計算結果 (Result)
+ * @return      <none>
+ */
+void EphJcg::calc_val(Result& res) {
+  double v[kNumQty];  // 天体毎の値（Qty 順）
+
+  try {
+    calc_body(kGrpSun, tm, v);
+    res.sun_ra   = v[kQtyRa];                           // R.A. (太陽) (h)
+    res.sun_dec  = v[kQtyDec];                          // Dec. (太陽) (°)
+    res.sun_dist = v[kQtyDist];                         // Dist.(太陽) (au)
+    calc_body(kGrpVns, tm, v);
+    res.vns_ra   = v[kQtyRa];                           // R.A. (金星) (h)
+    res.vns_dec  = v[kQtyDec];                          // Dec. (金星) (°)
+    res.vns_dist = v[kQtyDist];                         // Dist.(金星) (au)
+    calc_body(kGrpMrs, tm, v);
+    res.mrs_ra   = v[kQtyRa];                           // R.A. (火星) (h)
+    res.mrs_dec  = v[kQtyDec];                          // Dec. (火星) (°)
+    res.mrs_dist = v[kQtyDist];                         // Dist.(火星) (au)
+    calc_body(kGrpJpt, tm, v);
+    res.jpt_ra   = v[kQtyRa];                           // R.A. (木星) (h)
+    res.jpt_dec  = v[kQtyDec];                          // Dec. (木星) (°)
+    res.jpt_dist = v[kQtyDist];                         // Dist.(木星) (au)
+    calc_body(kGrpSat, tm, v);
+    res.sat_ra   = v[kQtyRa];                           // R.A. (土星) (h)
+    res.sat_dec  = v[kQtyDec];                          // Dec. (土星) (°)
+    res.sat_dist = v[kQtyDist];                         // Dist.(土星) (au)
+    calc_body(kGrpMon, tm, v);
+    res.mon_ra   = v[kQtyRa];                           // R.A. (月) (h)
+    res.mon_dec  = v[kQtyDec];                          // Dec. (月) (°)
+    res.mon_hp   = v[kQtyHp];                           // H.P. (月) (°)
+    res.r        = calc_cmn(kGrpR,   kQtyR,  tm_r);     // R
+    res.eps      = calc_cmn(kGrpR,   kQtyEps,  tm);     // ε
+    res.sun_hg   = calc_hg(res.r, res.sun_ra);          // グリニッジ時角（太陽）
+    res.vns_hg   = calc_hg(res.r, res.vns_ra);          // グリニッジ時角（金星）
+    res.mrs_hg   = calc_hg(res.r, res.mrs_ra);          // グリニッジ時角（火星）
+    res.jpt_hg   = calc_hg(res.r, res.jpt_ra);          // グリニッジ時角（木星）
+    res.sat_hg   = calc_hg(res.r, res.sat_ra);          // グリニッジ時角（土星）
+    res.mon_hg   = calc_hg(res.r, res.mon_ra);          // グリニッジ時角（月）
+    res.sun_sd   = calc_sd_sun(res.sun_dist);           // 視半径（太陽）
+    res.vns_sd   = calc_sd_etc(kS0Vns, res.vns_dist);   // 視半径（金星）
+    res.mrs_sd   = calc_sd_etc(kS0Mrs, res.mrs_dist);   // 視半径（火星）
+    res.jpt_sd_p = calc_sd_etc(kS0JptP, res.jpt_dist);  // 視半径（木星）
+    res.jpt_sd_e = calc_sd_etc(kS0JptE, res.jpt_dist);  // 視半径（木星）
+    res.sat_sd_p = calc_sd_etc(kS0SatP, res.sat_dist);  // 視半径（土星）
+    res.sat_sd_e = calc_sd_etc(kS0SatE, res.sat_dist);  // 視半径（土星）
+    res.mon_sd   = calc_sd_mon(res.mon_hp);             // 視半径（月）
   } catch (...) {
     throw;
   }
@@ -172,44 +362,20 @@ void EphJcg::calc_val() {
 /*
  * @brief      計算: 共通
  *
- * @param[in]  区分 (string)
+ * @param[in]  区分 (unsigned int; Grp)
+ * @param[in]  値 (unsigned int; Qty)
  * @param[in]  時刻引数 (double)
- * @return     <none>
+ * @return     値 (double)
  */
-double EphJcg::calc_cmn(std::string div, double tm) {
-  unsigned int a = 0;
-  unsigned int b = 0;
-  double       theta;
-  double       v = 0.0;
+double EphJcg::calc_cmn(unsigned int g, unsigned int q, double tm) {
+  const Seg&      seg = prm->grp[g].seg[i_seg[g]];
+  double          theta;
+  double          v = 0.0;
 
   try {
-    if        (div == "SUN_RA" || div == "SUN_DEC" || div == "SUN_DIST") {
-      a = std::get<0>(ab["SUN"]);
-      b = std::get<1>(ab["SUN"]);
-    } else if (div == "VNS_RA" || div == "VNS_DEC" || div == "VNS_DIST") {
-      a = std::get<0>(ab["VNS"]);
-      b = std::get<1>(ab["VNS"]);
-    } else if (div == "MRS_RA" || div == "MRS_DEC" || div == "MRS_DIST") {
-      a = std::get<0>(ab["MRS"]);
-      b = std::get<1>(ab["MRS"]);
-    } else if (div == "JPT_RA" || div == "JPT_DEC" || div == "JPT_DIST") {
-      a = std::get<0>(ab["JPT"]);
-      b = std::get<1>(ab["JPT"]);
-    } else if (div == "SAT_RA" || div == "SAT_DEC" || div == "SAT_DIST") {
-      a = std::get<0>(ab["SAT"]);
-      b = std::get<1>(ab["SAT"]);
-    } else if (div == "MON_RA" || div == "MON_DEC" || div == "MON_HP"  ) {
-      a = std::get<0>(ab["MON"]);
-      b = std::get<1>(ab["MON"]);
-    } else if (div == "R" || div == "EPS") {
-      a = std::get<0>(ab[div]);
-      b = std::get<1>(ab[div]);
-    }
-    theta = calc_theta(a, b, tm);
-    v = calc_ft(div, theta);
-    if (div == "SUN_RA" || div == "VNS_RA" || div == "MRS_RA" ||
-        div == "JPT_RA" || div == "SAT_RA" || div == "MON_RA" ||
-        div == "R") {
+    theta = calc_theta(seg.a, seg.b, tm);
+    v = calc_ft(seg, q, theta);
+    if (q == kQtyRa) {  // R.A., R
       while (v >= 24.0) v -= 24.0;
       while (v <   0.0) v += 24.0;
     }
@@ -220,6 +386,48 @@ double EphJcg::calc_cmn(std::string div, double tm) {
   return v;
 }
 
+/*
+ * @brief       計算: 天体毎（R.A., Dec., Dist.（月は H.P.）を一括）
+ *              * 3値は同じ適用期間・時刻引数を使うので、θ と cos(iθ) を1回だけ
+ *                求め、番号毎に並んだ係数（c[番号][値]）との積和を取る。
+ *              * 打ち切り（Seg::n_c）で項数が値毎に異なる場合は、共通の項数までを
+ *                一括で、残りを値毎に足す。（各値の加算順は calc_ft と同じ）
+ *
+ * @param[in]   区分 (unsigned int; Grp; R, 黄道傾角以外)
+ * @param[in]   時刻引数 (double)
+ * @param[out]  値 (double[kNumQty]; Qty 順)
+ * @return      <none>
+ */
+void EphJcg::calc_body(unsigned int g, double tm, double* v) {
+  const Seg& seg = prm->grp[g].seg[i_seg[g]];
+  double     theta;
+  double     bs[kNumCoefMax];  // cos(iθ)
+  unsigned int n_min;          // 項数（最小）
+  unsigned int n_max;          // 項数（最大）
+  unsigned int i;
+  unsigned int q;
+
+  try {
+    theta = calc_theta(seg.a, seg.b, tm);
+    n_min = std::min({seg.n_c[0], seg.n_c[1], seg.n_c[2]});
+    n_max = std::max({seg.n_c[0], seg.n_c[1], seg.n_c[2]});
+    for (i = 0; i < n_max; ++i) bs[i] = cos(theta * i * kPi / 180.0);
+    v[0] = v[1] = v[2] = 0.0;
+    for (i = 0; i < n_min; ++i) {
+      v[0] += seg.c[i][0] * bs[i];
+      v[1] += seg.c[i][1] * bs[i];
+      v[2] += seg.c[i][2] * bs[i];
+    }
+    for (q = 0; q < kNumQty; ++q) {
+      for (i = n_min; i < seg.n_c[q]; ++i) v[q] += seg.c[i][q] * bs[i];
+    }
+    while (v[kQtyRa] >= 24.0) v[kQtyRa] -= 24.0;
+    while (v[kQtyRa] <   0.0) v[kQtyRa] += 24.0;
+  } catch (...) {
+    throw;
+  }
+}
+
 /*
  * @brief      計算: θ
  *
@@ -251,25 +459,18 @@ double EphJcg::calc_theta(unsigned int a, unsigned int b, double tm) {
  *                 f(t) = C_0 + C_1 * cos(θ) + C_2 * cos(2θ) + ...
  *                      + C_N * cos(Nθ)
  *
- * @param[in]  区分 (string)
+ * @param[in]  係数 (Seg; 項数は Seg::n_c)
+ * @param[in]  値 (unsigned int; Qty)
  * @param[in]  θ (double)
  * @return     ft (double)
  */
-double EphJcg::calc_ft(std::string div, double theta) {
+double EphJcg::calc_ft(const Seg& seg, unsigned int q, double theta) {
   unsigned int i;
-  unsigned int i_max;
   double ft = 0.0;
 
   try {
-    if (div == "R" || div == "EPS") {
-      i_max = kSizeR;
-    } else if (div == "MON_RA" || div == "MON_DEC" || div == "MON_HP") {
-      i_max = kSizeM;
-    } else {
-      i_max = kSizeS;
-    }
-    for (i = 0; i < i_max; ++i) {
-      ft += param[div][i] * cos(theta * i * kPi / 180.0);
+    for (i = 0; i < seg.n_c[q]; ++i) {
+      ft += seg.c[i][q] * cos(theta * i * kPi / 180.0);
     }
   } catch (...) {
     throw;
@@ -281,14 +482,15 @@ double EphJcg::calc_ft(std::string div, double theta) {
 /*
  * @brief      計算: グリニッジ時角
  *
+ * @param[in]  R (double)
  * @param[in]  R.A. (double)
  * @return     グリニッジ時角 (double)
  */
-double EphJcg::calc_hg(double ra) {
+double EphJcg::calc_hg(double r, double ra) {
   double hg;
 
   try {
-    hg = r - ra + f * 24.0;;
+    hg = r - ra + f * 24.0;
   } catch (...) {
     throw;
   }
@@ -301,14 +503,14 @@ double EphJcg::calc_hg(double ra) {
  *          * 次式により視半径を計算する。
  *              S.D. = 16.02 ′/ Dist.
  *
- * @param   <none>
- * @return  視半径 (double)
+ * @param[in]  Dist. (double)
+ * @return     視半径 (double)
  */
-double EphJcg::calc_sd_sun() {
+double EphJcg::calc_sd_sun(double dist) {
   double sd;
 
   try {
-    sd = kS0Sun / sun_dist;
+    sd = kS0Sun / dist;
   } catch (...) {
     throw;
   }
@@ -321,14 +523,14 @@ double EphJcg::calc_sd_sun() {
  *          * 次式により視半径を計算する。
  *              S.D. = sin^(-1) (0.2725 * sin(H.P.))
  *
- * @param   <none>
- * @return  視半径 (double)
+ * @param[in]  H.P. (double)
+ * @return     視半径 (double)
  */
-double EphJcg::calc_sd_mon() {
+double EphJcg::calc_sd_mon(double hp) {
   double sd;
 
   try {
-    sd = asin(kS0Mon * sin(mon_hp * kPi / 180.0)) * 60.0 * 180.0 / kPi;
+    sd = asin(kS0Mon * sin(hp * kPi / 180.0)) * 60.0 * 180.0 / kPi;
   } catch (...) {
     throw;
   }
@@ -1,22 +1,27 @@
 #ifndef EPHEMERIS_JCG_EPH_JCG_HPP_
 #define EPHEMERIS_JCG_EPH_JCG_HPP_
 
+#include "common.hpp"
 #include "file.hpp"
+#include "result.hpp"
+#include "trunc.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>   // for EXIT_XXXX
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
-#include <tuple>
-#include <unordered_map>
-#include <vector>
 
 namespace ephemeris_jcg {
 
-class EphJcg {
-  std::unordered_map<unsigned int, unsigned int> l_dlt_t;   // List of ΔT
+// * 計算結果（Result）のメンバは、直近に calc(struct timespec) で計算した値。
+// * 読み込み済みの係数を渡した場合は参照のみ保持する。（係数は呼び出し元で保持すること）
+class EphJcg : public Result {
+  std::unique_ptr<Param> prm_own;  // 係数（1年分; 自身で読み込んだ場合）
+  const Param* prm;        // 係数（1年分）
   struct timespec ts;      // timespec of UT1
   unsigned int year;       // 西暦年(UT1)
   unsigned int month;      // 月(UT1)
@@ -27,64 +32,37 @@ class EphJcg {
   unsigned int nsec;       // ナノ秒(UT1)
   unsigned int t;          // 通日 T（1月0日を第0日とする）
   double f;                // UT1 の日の端数
-  unsigned int dlt_t;      // ΔT（TT（地球時） - UT1（世界時1））
   double tm;               // 計算用時刻引数
   double tm_r;             // 計算用時刻引数（R 計算用）
-  std::unordered_map<std::string,
-                     std::tuple<unsigned int, unsigned int>> ab;  // 係数適用期間一覧
-  std::unordered_map<std::string, std::vector<double>> param;     // 係数一覧
+  unsigned int i_seg[kNumGrp];  // 適用期間（区分毎の Param::grp[].seg の添字）
+  TruncStat trc;           // 打ち切りの結果（許容誤差を指定して読み込んだ場合）
 
 public:
-  double sun_ra;            // SUN R.A.
-  double sun_dec;           // SUN Dec.
-  double sun_dist;          // SUN Dist.
-  double vns_ra;            // VNS R.A.
-  double vns_dec;           // VNS Dec.
-  double vns_dist;          // VNS Dist.
-  double mrs_ra;            // MRS R.A.
-  double mrs_dec;           // MRS Dec.
-  double mrs_dist;          // MRS Dist.
-  double jpt_ra;            // JPT R.A.
-  double jpt_dec;           // JPT Dec.
-  double jpt_dist;          // JPT Dist.
-  double sat_ra;            // SAT R.A.
-  double sat_dec;           // SAT Dec.
-  double sat_dist;          // SAT Dist.
-  double mon_ra;            // MON R.A.
-  double mon_dec;           // MON Dec.
-  double mon_hp;            // MON H.P.
-  double r;                 // R
-  double eps;               // ε
-  double sun_hg;            // SUN グリニッジ時角
-  double vns_hg;            // VNS グリニッジ時角
-  double mrs_hg;            // MRS グリニッジ時角
-  double jpt_hg;            // JPT グリニッジ時角
-  double sat_hg;            // SAT グリニッジ時角
-  double mon_hg;            // MON グリニッジ時角
-  double sun_sd;            // SUN 視半径
-  double vns_sd;            // VNS 視半径
-  double mrs_sd;            // MRS 視半径
-  double jpt_sd;            // JPT 視半径
-  double sat_sd;            // SAT 視半径
-  double jpt_sd_p;          // JPT 視半径（極半径）
-  double jpt_sd_e;          // JPT 視半径（赤道半径）
-  double sat_sd_p;          // SAT 視半径（極半径）
-  double sat_sd_e;          // SAT 視半径（赤道半径）
-  double mon_sd;            // MON 視半径
-  EphJcg(struct timespec);  // コンストラクタ
+  EphJcg(struct timespec, double = 0.0);  // コンストラクタ（係数読み込み・計算）
+  EphJcg(const Param&);     // コンストラクタ（読み込み済み係数）
+  void calc(struct timespec);           // 計算（アロケーション無し）
+  void calc(struct timespec, Result&);  // 計算（アロケーション無し; 結果は引数へ）
+  void calc(int, unsigned int, double, Result&);  // 計算（変換済みの時刻; ts2tf）
+  void calc(const struct timespec*, std::size_t, Result*);  // 計算（多数の時刻; 同年）
+  unsigned int get_year() const;        // 取得: 係数の西暦年
+  double get_tm() const;                // 取得: 計算用時刻引数
+  double get_f() const;                 // 取得: UT1 の日の端数
+  const TruncStat& get_trunc() const;   // 取得: 打ち切りの結果
 
 private:
   void get_ut1();      // 取得: UT1（年・月・日・時・分・秒・ナノ秒）
   void calc_t();       // 計算: 通日 T
   void calc_f();       // 計算: UT1 の日の端数
   void calc_tm();      // 計算: 計算用時刻引数
-  void calc_val();     // 計算: 各種
-  double calc_cmn(std::string, double);                   // 計算: 共通
+  void calc_seg();     // 計算: 適用期間
+  void calc_val(Result&);  // 計算: 各種
+  double calc_cmn(unsigned int, unsigned int, double);    // 計算: 共通
+  void calc_body(unsigned int, double, double*);          // 計算: 天体毎（3値を一括）
   double calc_theta(unsigned int, unsigned int, double);  // 計算: θ
-  double calc_ft(std::string, double);                    // 計算: 所要値
-  double calc_hg(double);                                 // 計算: グリニッジ時角
-  double calc_sd_sun();                                   // 計算: 視半径（太陽）
-  double calc_sd_mon();                                   // 計算: 視半径（月）
+  double calc_ft(const Seg&, unsigned int, double);       // 計算: 所要値
+  double calc_hg(double, double);                         // 計算: グリニッジ時角
+  double calc_sd_sun(double);                             // 計算: 視半径（太陽）
+  double calc_sd_mon(double);                             // 計算: 視半径（月）
   double calc_sd_etc(double, double);                     // 計算: 視半径（金・火・木・土星）
 };
 
@@ -0,0 +1,26 @@
+#include "eph_year.hpp"
+
+namespace ephemeris_jcg {
+
+/*
+ * @brief      取得: 年毎の計算
+ *             * 初回のみ対象年の係数を読み込む。
+ *
+ * @param[in]  西暦年 (unsigned int)
+ * @return     計算 (EphJcg&)
+ */
+EphJcg& EphYear::get(unsigned int year) {
+  File o_f;
+
+  for (auto& e : eph) {
+    if (e.first == year) return *e.second;
+  }
+  prm.emplace_back(new Param);
+  o_f.get_param(year, *prm.back());
+  eph.emplace_back(year, std::unique_ptr<EphJcg>(new EphJcg(*prm.back())));
+
+  return *eph.back().second;
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,30 @@
+#ifndef EPHEMERIS_JCG_EPH_YEAR_HPP_
+#define EPHEMERIS_JCG_EPH_YEAR_HPP_
+
+#include "eph_jcg.hpp"
+#include "file.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 年毎の係数・計算（必要な年のみ読み込み）
+// * 初回の取得時に対象年の係数を読み込み、以降は同じ計算（EphJcg）を返す。
+// * 複数年にまたがる計算（RiseSet, CelFix）で共用する。
+class EphYear {
+  std::vector<std::unique_ptr<Param>> prm;  // 年毎の係数
+  std::vector<std::pair<unsigned int, std::unique_ptr<EphJcg>>> eph;  // 年毎の計算
+
+public:
+  EphJcg& get(unsigned int);  // 取得: 年毎の計算
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
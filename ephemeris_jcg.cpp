@@ -12,24 +12,260 @@
                  （先頭から、西暦年(4), 月(2), 日(2), 時(2), 分(2), 秒(2),
                              1秒未満(9)（小数点以下9桁（ナノ秒）まで））
                  無指定なら現在(システム日時)と判断。
+         --bulk YYYY FILE [STEP]
+           西暦年 YYYY の1年分を STEP 秒（既定: 1）間隔で計算し、
+           アーカイブ FILE に書き込む。
+         --input FILE [OUT]
+           FILE（"-" なら標準入力）の各行の UT1（23桁の数字 | ISO-8601）を
+           計算し、 CSV で OUT（既定: 標準出力）に書き込む。
+         --screen YYYY [YYYY]
+           指定期間の日食・月食・惑星食の候補を検索する。
+         --publish NAME [HZ]
+           現在時刻を HZ 回/秒（既定: 1）計算し、共有メモリ NAME（"/..."）に
+           公開し続ける。（購読側は ShmSub（shm_sub.hpp）で読み取る）
+         --tol SEC（他の引数の前に指定）
+           係数を許容誤差 SEC（″）で打ち切って計算する。（UT1, --input,
+           --publish で有効（--bulk, --screen はエラー）; 保証される誤差の
+           上限を標準エラー出力に表示）
 ***********************************************************/
+#include "archive.hpp"
 #include "common.hpp"
 #include "eph_jcg.hpp"
+#include "pipeline.hpp"
+#include "screen.hpp"
+#include "shm.hpp"
+#include "store.hpp"
 
 #include <cstdlib>   // for EXIT_XXXX
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      表示: 打ち切りの結果（標準エラー出力）
+ *
+ * @param[in]  許容誤差 (double; ″)
+ * @param[in]  打ち切りの結果 (TruncStat)
+ * @return     <none>
+ */
+static void print_trunc(double tol, const ns::TruncStat& trc) {
+  std::cerr << "[ TOL: " << tol << " ″ -> error <= "
+            << trc.err_ang << " ″ (hG: R " << trc.err_r << " + R.A. "
+            << trc.err_ra << "), dist <= " << trc.err_dist
+            << " (relative), " << trc.n_term << " / " << trc.n_all
+            << " terms ]" << std::endl;
+}
+
+/*
+ * @brief      一括生成（--bulk YYYY FILE [STEP]）
+ *
+ * @param[in]  引数の数 (int)
+ * @param[in]  引数 (char*[])
+ * @return     EXIT_SUCCESS | EXIT_FAILURE
+ */
+static int run_bulk(int argc, char* argv[]) {
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  ns::File o_f;
+  ns::DateTime dt = {};
+  struct timespec t0;   // 先頭時刻
+  struct timespec t1;   // 翌年の先頭時刻
+  unsigned int year;    // 西暦年
+  long long step = 1;   // 時刻間隔（秒）
+  std::size_t n;        // 件数
+
+  try {
+    if (argc < 4) {
+      std::cout << "[ERROR] Usage: --bulk YYYY FILE [STEP]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    year = std::stoi(argv[2]);
+    if (argc > 4) step = std::stoll(argv[4]);
+    if (step <= 0) {
+      std::cout << "[ERROR] Invalid step!" << std::endl;
+      return EXIT_FAILURE;
+    }
+    o_f.get_param(year, *prm);
+    dt.year  = year;
+    dt.month = 1;
+    dt.day   = 1;
+    t0 = ns::dt2ts(dt);
+    dt.year  = year + 1;
+    t1 = ns::dt2ts(dt);
+    n = (t1.tv_sec - t0.tv_sec + step - 1) / step;
+    ns::write_archive(*prm, t0, step * 1000000000LL, n, argv[3]);
+    std::cout << "[ " << n << " instants -> " << argv[3] << " ]" << std::endl;
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*
+ * @brief      一括計算（--input FILE [OUT]）
+ *
+ * @param[in]  引数の数 (int)
+ * @param[in]  引数 (char*[])
+ * @param[in]  許容誤差 (double; ″; 0 なら打ち切らない)
+ * @return     EXIT_SUCCESS | EXIT_FAILURE
+ */
+static int run_input(int argc, char* argv[], double tol) {
+  std::FILE* in  = stdin;   // 入力
+  std::FILE* out = stdout;  // 出力
+  std::string f;            // 入力ファイル名
+
+  try {
+    if (argc < 3) {
+      std::cout << "[ERROR] Usage: --input FILE|- [OUT]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    f = argv[2];
+    if (f != "-") in = std::fopen(f.c_str(), "rb");
+    if (in == nullptr) {
+      std::cout << "[ERROR] Could not open \"" << f << "\"!" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (argc > 3) out = std::fopen(argv[3], "wb");
+    if (out == nullptr) {
+      std::cout << "[ERROR] Could not open \"" << argv[3] << "\"!" << std::endl;
+      return EXIT_FAILURE;
+    }
+    ns::Store st(tol);
+    if (tol > 0.0) print_trunc(tol, ns::Store::Reader(st).get().trc);
+    ns::Pipeline o_p(st);
+    o_p.run(in, out);
+    if (in  != stdin)  std::fclose(in);
+    if (out != stdout) std::fclose(out);
+    std::cerr << "[ " << o_p.get_n_out() << " instants, "
+              << o_p.get_n_bad() + o_p.get_n_skip() << " skipped ]" << std::endl;
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*
+ * @brief      食・星食の候補の検索（--screen YYYY [YYYY]）
+ *
+ * @param[in]  引数の数 (int)
+ * @param[in]  引数 (char*[])
+ * @return     EXIT_SUCCESS | EXIT_FAILURE
+ */
+static int run_screen(int argc, char* argv[]) {
+  static constexpr char kEclName[ns::kNumEcl][8] = {
+    "SOLAR", "LUNAR", "VENUS", "MARS", "JUPITER", "SATURN"};
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  std::vector<ns::EclCand> cand;                   // 候補
+  ns::File o_f;
+  ns::Screen o_s;
+  unsigned int y0;  // 西暦年（開始）
+  unsigned int y1;  // 西暦年（終了）
+  unsigned int y;
+
+  try {
+    if (argc < 3) {
+      std::cout << "[ERROR] Usage: --screen YYYY [YYYY]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    y0 = std::stoi(argv[2]);
+    y1 = (argc > 3) ? std::stoi(argv[3]) : y0;
+    for (y = y0; y <= y1; ++y) {
+      o_f.get_param(y, *prm);
+      o_s.calc(*prm, cand);
+    }
+    std::cout << std::fixed << std::setprecision(4);
+    for (auto& c : cand) {
+      std::cout << std::left << std::setw(8) << kEclName[c.kind] << std::right
+                << ns::gen_time_str(c.max)
+                << "  sep = " << std::setw(7) << c.sep
+                << "  lim = " << std::setw(7) << c.lim
+                << "  [" << ns::gen_time_str(c.bgn)
+                << " - " << ns::gen_time_str(c.end) << "]" << std::endl;
+    }
+    std::cerr << "[ " << o_s.get_stat().n_piece << " pieces, "
+              << o_s.get_stat().n_prune << " pruned, "
+              << o_s.get_stat().n_node << " nodes, "
+              << o_s.get_stat().n_leaf << " leaves ]" << std::endl;
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*
+ * @brief      共有メモリへの公開（--publish NAME [HZ]）
+ *             * 係数・ΔT ファイルの更新は 60 秒毎に確認する。
+ *
+ * @param[in]  引数の数 (int)
+ * @param[in]  引数 (char*[])
+ * @param[in]  許容誤差 (double; ″; 0 なら打ち切らない)
+ * @return     EXIT_SUCCESS | EXIT_FAILURE
+ */
+static int run_publish(int argc, char* argv[], double tol) {
+  double hz = 1.0;  // 周波数（Hz）
+
+  try {
+    if (argc < 3 || argv[2][0] != '/') {
+      std::cout << "[ERROR] Usage: --publish /NAME [HZ]" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (argc > 3) hz = std::stod(argv[3]);
+    if (!(hz > 0.0)) {
+      std::cout << "[ERROR] Invalid rate!" << std::endl;
+      return EXIT_FAILURE;
+    }
+    ns::Store st(tol);
+    if (tol > 0.0) print_trunc(tol, ns::Store::Reader(st).get().trc);
+    ns::ShmPub o_p(argv[2]);
+    st.watch(60000);
+    o_p.run(st, hz);
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
 
 int main(int argc, char* argv[]) {
   std::string tm_str;   // time string
   unsigned int s_tm;    // size of time string
-  int s_nsec;           // size of nsec string
   int ret;              // return of functions
   struct timespec ut1;  // UTC
-  struct tm t = {};     // for work
-  namespace ns = ephemeris_jcg;
+  double tol = 0.0;     // 許容誤差（″）
+
+  // 許容誤差（--tol SEC; 以降の引数は詰める）
+  if (argc > 1 && std::string(argv[1]) == "--tol") {
+    if (argc < 3 || !(std::strtod(argv[2], nullptr) > 0.0)) {
+      std::cout << "[ERROR] Usage: --tol SEC ..." << std::endl;
+      return EXIT_FAILURE;
+    }
+    tol = std::strtod(argv[2], nullptr);
+    argv[2] = argv[0];
+    argv += 2;
+    argc -= 2;
+    if (argc > 1 && (std::string(argv[1]) == "--bulk" ||
+                     std::string(argv[1]) == "--screen")) {
+      std::cout << "[ERROR] --tol is not available with " << argv[1] << "!"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (argc > 1 && std::string(argv[1]) == "--bulk") return run_bulk(argc, argv);
+  if (argc > 1 && std::string(argv[1]) == "--input") return run_input(argc, argv, tol);
+  if (argc > 1 && std::string(argv[1]) == "--screen") return run_screen(argc, argv);
+  if (argc > 1 && std::string(argv[1]) == "--publish") return run_publish(argc, argv, tol);
 
   try {
     // 日付取得
@@ -41,14 +277,9 @@ int main(int argc, char* argv[]) {
         std::cout << "[ERROR] Over 23-digits!" << std::endl;
         return EXIT_FAILURE;
       }
-      s_nsec = s_tm - 14;
-      std::istringstream is(tm_str);
-      is >> std::get_time(&t, "%Y%m%d%H%M%S");
-      ut1.tv_sec  = mktime(&t);
-      ut1.tv_nsec = 0;
-      if (s_tm > 14) {
-        ut1.tv_nsec = std::stod(
-            tm_str.substr(14, s_nsec) + std::string(9 - s_nsec, '0'));
+      if (!ns::parse_ut1(tm_str.c_str(), s_tm, ut1)) {
+        std::cout << "[ERROR] Invalid format!" << std::endl;
+        return EXIT_FAILURE;
       }
     } else {
       // 現在日時の取得
@@ -60,7 +291,8 @@ int main(int argc, char* argv[]) {
     }
 
     // Calculation & display
-    ns::EphJcg o_e(ut1);
+    ns::EphJcg o_e(ut1, tol);
+    if (tol > 0.0) print_trunc(tol, o_e.get_trunc());
     std::cout << "[ UT1: " << ns::gen_time_str(ut1) << " ]" << std::endl;
     std::cout << std::fixed << std::setprecision(8);
     std::cout << "SUN     R.A. =  "
@@ -4,6 +4,8 @@ namespace ephemeris_jcg {
 
 // 定数
 const constexpr char kDeltaT[]  = "txt/delta_t.txt";
+const constexpr char kParamD[]  = "txt";
+const constexpr char kParamN[]  = "na";
 const constexpr char kParamP[]  = "txt/na";
 const constexpr char kParamS[]  = "-data.txt";
 const constexpr char kStrSun[]  = "^太陽の";
@@ -21,6 +23,8 @@ const constexpr char kStrAB[]   =
     "a\\s*=\\s*(\\d+)\\s*,\\s*b\\s*=\\s*(\\d+).*"
     "a\\s*=\\s*(\\d+)\\s*,\\s*b\\s*=\\s*(\\d+).*"
     "a\\s*=\\s*(\\d+)\\s*,\\s*b\\s*=\\s*(\\d+)$";
+const constexpr char kStrNo[]   = "No\\.\\s*(\\d+)\\s+";
+const constexpr char kStrABs[]  = "a\\s*=\\s*(\\d+)\\s*,\\s*b\\s*=\\s*(\\d+)";
 const constexpr char kStrVal9[] =
     "(\\d+)\\s+"
     "([\\-\\d\\.]+)\\s+([\\-\\d\\.]+)\\s+([\\-\\d\\.]+)\\s+"
@@ -33,6 +37,27 @@ const constexpr char kStrVal6[] =
     "([\\-\\d\\.]+)\\s+([\\-\\d\\.]+)\\s+([\\-\\d\\.]+)\\s+"
     "\\d+";
 
+/*
+ * @brief      コンストラクタ
+ *
+ * @param[in]  例外モード (bool; 既定: false)
+ */
+File::File(bool thr) : thr(thr) {}
+
+/*
+ * @brief      エラー
+ *             * 例外モードでは std::runtime_error を送出し、それ以外は
+ *               エラーを表示して終了する。
+ *
+ * @param[in]  メッセージ (string)
+ * @return     <none>
+ */
+void File::fail(const std::string& msg) {
+  if (thr) throw std::runtime_error(msg);
+  std::cout << "[ERROR] " << msg << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
 /*
  * @brief      ΔT 一覧取得
  *
@@ -51,10 +76,7 @@ unsigned int File::get_delta_t(unsigned int year) {
   try {
     // ファイル OPEN
     std::ifstream ifs(f);
-    if (!ifs) {
-      std::cout << "[ERROR] Could not open \"" << f << "\"!" << std::endl;
-      std::exit(EXIT_FAILURE);
-    }
+    if (!ifs) fail("Could not open \"" + f + "\"!");
 
     // ファイル READ
     while (getline(ifs, buf)) {
@@ -79,19 +101,15 @@ unsigned int File::get_delta_t(unsigned int year) {
  *                月         : 30 件
  *                その他     : 18 件
  *                であるはずだが、件数のチェックは行わない。（現時点）
+ *              * 書き込み途中などで、適用期間の無い区分、係数の行の欠けた
+ *                適用期間があれば不正とする。
+ *              * 計算時刻に依らず、1年分の全ての適用期間の係数を取得する。
  *
  * @param[in]   西暦年 (unsigned int)
- * @param[in]   計算用時刻引数 (double)
- * @param[in]   計算用時刻引数 (double)
- * @param[ref]  係数適用期間一覧
- *              (unordered_map<string, tuple<unsigned int, unsigned int>>)
- * @param[ref]  係数一覧 (unordered_map<string, vector>)
+ * @param[ref]  係数 (Param)
  * @return      <none>
  */
-void File::get_param(
-    unsigned int year, double tm, double tm_r,
-    std::unordered_map<std::string, std::tuple<unsigned int, unsigned int>>& ab,
-    std::unordered_map<std::string, std::vector<double>>& param) {
+void File::get_param(unsigned int year, Param& prm) {
   std::string f;                  // ファイル名
   std::string buf;                // 1行分バッファ
   std::smatch sm;                 // 正規表現マッチ
@@ -109,53 +127,59 @@ void File::get_param(
   std::regex re_val_9(kStrVal9);  // 正規表現: 値9列
   std::regex re_val_6(kStrVal6);  // 正規表現: 値6列
   std::string s;                  // 1行分文字列
-  std::string div = "";           // 区分
-  int c = -1;                     // 対象カラム(-1(無し), 0 - 2)
+  int g = -1;                     // 区分(-1(無し), Grp)
+  int s0 = -1;                    // 対象適用期間の先頭(-1(無し), 0 - )
+  unsigned int n_row[kNumGrp][kNumSegMax] = {};  // 係数の行数（適用期間毎）
+  unsigned int n;                 // 係数の番号
   unsigned int i;                 // loop index
+  unsigned int q;                 // loop index
 
   try {
+    prm = Param();
+    prm.year = year;
+
+    // ΔT
+    prm.dlt_t = get_delta_t(year);
+    if (prm.dlt_t == 0) fail(std::to_string(year) + " is out of range!");
+
     // ファイル名
     f = kParamP + std::to_string(year).substr(2, 2) + kParamS;
 
     // ファイル OPEN
     std::ifstream ifs(f);
-    if (!ifs) {
-      std::cout << "[ERROR] Could not open \"" << f << "\"!" << std::endl;
-      std::exit(EXIT_FAILURE);
-    }
+    if (!ifs) fail("Could not open \"" + f + "\"!");
 
     // ファイル READ
     while (getline(ifs, buf)) {
-      std::istringstream iss(buf);
       s = std::regex_replace(buf, re_sp, "");
       // 区分取得
       if        (std::regex_search(s, sm, re_sun)) {
-        div = "SUN";
-        c = -1;
+        g = kGrpSun;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_vns)) {
-        div = "VNS";
-        c = -1;
+        g = kGrpVns;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_mrs)) {
-        div = "MRS";
-        c = -1;
+        g = kGrpMrs;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_jpt)) {
-        div = "JPT";
-        c = -1;
+        g = kGrpJpt;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_sat)) {
-        div = "SAT";
-        c = -1;
+        g = kGrpSat;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_mon)) {
-        div = "MON";
-        c = -1;
+        g = kGrpMon;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_r  )) {
-        div = "R";
-        c = -1;
+        g = kGrpR;
+        s0 = -1;
         continue;
       } else if (std::regex_search(s, sm, re_nul)) {
         continue;
@@ -163,71 +187,261 @@ void File::get_param(
         break;
       } else {
         // 係数一覧取得
-        if (c != -1) {
-          if        (std::regex_search(s, sm, re_val_9)) {
+        if (s0 != -1) {
+          GrpParam& gp = prm.grp[g];
+          if        (g != kGrpR && std::regex_search(s, sm, re_val_9)) {
             // R, EPS 以外
-            if        (div == "SUN") {
-              param["SUN_RA"  ].push_back(stod(sm[c * 3 + 2]));
-              param["SUN_DEC" ].push_back(stod(sm[c * 3 + 3]));
-              param["SUN_DIST"].push_back(stod(sm[c * 3 + 4]));
-            } else if (div == "VNS") {
-              param["VNS_RA"  ].push_back(stod(sm[c * 3 + 2]));
-              param["VNS_DEC" ].push_back(stod(sm[c * 3 + 3]));
-              param["VNS_DIST"].push_back(stod(sm[c * 3 + 4]));
-            } else if (div == "MRS") {
-              param["MRS_RA"  ].push_back(stod(sm[c * 3 + 2]));
-              param["MRS_DEC" ].push_back(stod(sm[c * 3 + 3]));
-              param["MRS_DIST"].push_back(stod(sm[c * 3 + 4]));
-            } else if (div == "JPT") {
-              param["JPT_RA"  ].push_back(stod(sm[c * 3 + 2]));
-              param["JPT_DEC" ].push_back(stod(sm[c * 3 + 3]));
-              param["JPT_DIST"].push_back(stod(sm[c * 3 + 4]));
-            } else if (div == "SAT") {
-              param["SAT_RA"  ].push_back(stod(sm[c * 3 + 2]));
-              param["SAT_DEC" ].push_back(stod(sm[c * 3 + 3]));
-              param["SAT_DIST"].push_back(stod(sm[c * 3 + 4]));
-            } else if (div == "MON") {
-              param["MON_RA" ].push_back(stod(sm[c * 3 + 2]));
-              param["MON_DEC"].push_back(stod(sm[c * 3 + 3]));
-              param["MON_HP" ].push_back(stod(sm[c * 3 + 4]));
+            n = stoi(sm[1]);
+            if (n >= kNumCoefMax) continue;
+            for (i = 0; i < 3; ++i) {
+              for (q = 0; q < 3; ++q) {
+                gp.seg[s0 + i].c[n][q] = stod(sm[i * 3 + q + 2]);
+              }
+              ++n_row[g][s0 + i];
             }
-          } else if (std::regex_search(s, sm, re_val_6)) {
+            if (gp.n_coef < n + 1) gp.n_coef = n + 1;
+          } else if (g == kGrpR && std::regex_search(s, sm, re_val_6)) {
             // R, EPS
-            param["R"  ].push_back(stod(sm[c * 2 + 2]));
-            param["EPS"].push_back(stod(sm[c * 2 + 3]));
+            n = stoi(sm[1]);
+            if (n >= kNumCoefMax) continue;
+            for (i = 0; i < 3; ++i) {
+              for (q = 0; q < 2; ++q) {
+                gp.seg[s0 + i].c[n][q] = stod(sm[i * 2 + q + 2]);
+              }
+              ++n_row[g][s0 + i];
+            }
+            if (gp.n_coef < n + 1) gp.n_coef = n + 1;
           }
         }
       }
-      if (div == "") continue;
-      // 適用期間 a, b, 列取得
+      if (g == -1) continue;
+      // 適用期間 a, b 取得
       if (std::regex_match(s, sm, re_ab)) {
-        if (div == "R") {
-          for (i = 0; i < 3; ++i) {
-            if (stod(sm[i * 2 + 1]) <= tm_r && tm_r < stod(sm[i * 2 + 2])) {
-              ab["R"  ] = std::make_tuple(stoi(sm[i * 2 + 1]),
-                                          stoi(sm[i * 2 + 2]));
-              ab["EPS"] = std::make_tuple(stoi(sm[i * 2 + 1]),
-                                          stoi(sm[i * 2 + 2]));
-              c = i;
-              break;
-            }
-          }
-        } else {
-          for (i = 0; i < 3; ++i) {
-            if (stod(sm[i * 2 + 1]) <= tm && tm < stod(sm[i * 2 + 2])) {
-              ab[div] = std::make_tuple(stoi(sm[i * 2 + 1]),
-                                        stoi(sm[i * 2 + 2]));
-              c = i;
-              break;
-            }
-          }
+        GrpParam& gp = prm.grp[g];
+        if (gp.n_seg + 3 > kNumSegMax) {
+          s0 = -1;
+          continue;
+        }
+        s0 = gp.n_seg;
+        for (i = 0; i < 3; ++i) {
+          gp.seg[s0 + i].a = stoi(sm[i * 2 + 1]);
+          gp.seg[s0 + i].b = stoi(sm[i * 2 + 2]);
+        }
+        gp.n_seg += 3;
+        continue;
+      }
+    }
+
+    // 内容の確認
+    for (g = 0; g < static_cast<int>(kNumGrp); ++g) {
+      const GrpParam& gp = prm.grp[g];
+      if (gp.n_seg == 0) fail("Invalid \"" + f + "\"!");
+      for (i = 0; i < gp.n_seg; ++i) {
+        if (gp.seg[i].a >= gp.seg[i].b || n_row[g][i] != gp.n_coef) {
+          fail("Invalid \"" + f + "\"!");
+        }
+      }
+    }
+
+    // 計算に使う係数の数（既定は全て）
+    for (auto& gp : prm.grp) {
+      for (i = 0; i < gp.n_seg; ++i) {
+        for (q = 0; q < kNumQty; ++q) gp.seg[i].n_c[q] = gp.n_coef;
+      }
+    }
+  } catch (const std::logic_error&) {
+    // 数値の変換エラー（stoi, stod）
+    if (!thr) throw;
+    fail("Invalid \"" + f + "\"!");
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       恒星の係数取得
+ *
+ *                「恒星の」で始まる見出し以降の、
+ *                  No.99  名称 ...（最大4個）
+ *                  a = 9 , b = 999 ...
+ *                  N  R.A. Dec. R.A. Dec. ... N
+ *                の繰り返しを読み込む。（改ページ・見出しの行は読み飛ばす）
+ *
+ * @param[in]   西暦年 (unsigned int)
+ * @param[ref]  恒星の係数 (StarCat)
+ * @return      <none>
+ */
+void File::get_star(unsigned int year, StarCat& cat) {
+  std::string f;                  // ファイル名
+  std::string buf;                // 1行分バッファ
+  std::string s;                  // 1行分文字列
+  std::string tok;                // 1語
+  std::smatch sm;                 // 正規表現マッチ
+  std::regex re_kos(kStrKos);     // 正規表現: 恒星
+  std::regex re_sp(kStrSp);       // 正規表現: 行頭スペース
+  std::regex re_no(kStrNo);       // 正規表現: No.99
+  std::regex re_ab(kStrABs);      // 正規表現: a = ..., b = ...
+  std::vector<std::vector<double>> c;  // 係数（恒星毎; R.A., Dec. を交互）
+  std::vector<double> v;          // 1行分の値
+  std::size_t s0 = 0;             // 対象恒星の先頭
+  std::size_t k  = 0;             // 対象恒星の数
+  std::size_t ia = 0;             // a, b の設定先
+  std::size_t i;
+  std::size_t j;
+  unsigned int n;                 // 係数の番号
+  bool in_star = false;           // 恒星の区分内
+
+  try {
+    cat = StarCat();
+    cat.year = year;
+
+    // ファイル名
+    f = kParamP + std::to_string(year).substr(2, 2) + kParamS;
+
+    // ファイル OPEN
+    std::ifstream ifs(f);
+    if (!ifs) fail("Could not open \"" + f + "\"!");
+
+    // ファイル READ
+    while (getline(ifs, buf)) {
+      s = std::regex_replace(buf, re_sp, "");
+      if (!in_star) {
+        in_star = std::regex_search(s, sm, re_kos);
+        continue;
+      }
+      // 番号・名称
+      if (std::regex_search(s, sm, re_no)) {
+        std::sregex_iterator it(s.begin(), s.end(), re_no);
+        std::sregex_iterator end;
+        s0 = cat.no.size();
+        k  = 0;
+        ia = 0;
+        for (; it != end; ++it) {
+          auto nx = std::next(it);
+          std::size_t p0 = it->position() + it->length();
+          std::size_t p1 = (nx == end) ? s.size() : nx->position();
+          cat.no.push_back(stoi((*it)[1]));
+          cat.name.push_back(std::regex_replace(s.substr(p0, p1 - p0), re_sp, ""));
+          cat.a.push_back(0.0);
+          cat.b.push_back(0.0);
+          c.emplace_back(2 * kNumCoefMax, 0.0);
+          ++k;
+        }
+        continue;
+      }
+      if (k == 0) continue;
+      // 適用期間 a, b
+      if (std::regex_search(s, sm, re_ab)) {
+        std::sregex_iterator it(s.begin(), s.end(), re_ab);
+        std::sregex_iterator end;
+        for (; it != end && ia < k; ++it, ++ia) {
+          cat.a[s0 + ia] = stod((*it)[1]);
+          cat.b[s0 + ia] = stod((*it)[2]);
         }
         continue;
       }
+      // 係数（N, R.A., Dec., ..., N の数値のみの行）
+      std::istringstream iss(s);
+      v.clear();
+      while (iss >> tok) {
+        if (tok.find_first_not_of("-.0123456789") != std::string::npos) break;
+        v.push_back(stod(tok));
+      }
+      if (!iss.eof() || v.size() != 2 * k + 2 || v.front() != v.back()) continue;
+      n = static_cast<unsigned int>(v.front());
+      if (n >= kNumCoefMax) continue;
+      for (i = 0; i < k; ++i) {
+        c[s0 + i][2 * n    ] = v[2 * i + 1];
+        c[s0 + i][2 * n + 1] = v[2 * i + 2];
+      }
+      if (cat.n_coef < n + 1) cat.n_coef = n + 1;
+    }
+
+    // 係数を列指向に並べ替え
+    cat.c_ra.resize(cat.n_coef * cat.no.size());
+    cat.c_dec.resize(cat.n_coef * cat.no.size());
+    for (i = 0; i < cat.n_coef; ++i) {
+      for (j = 0; j < cat.no.size(); ++j) {
+        cat.c_ra [i * cat.no.size() + j] = c[j][2 * i    ];
+        cat.c_dec[i * cat.no.size() + j] = c[j][2 * i + 1];
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      係数ファイルの存在する年の取得
+ *             * txt/ 内の na??-data.txt を検索する。
+ *
+ * @param[in]  <none>
+ * @return     西暦年（昇順） (vector<unsigned int>)
+ */
+std::vector<unsigned int> File::get_years() {
+  std::vector<unsigned int> years;  // 西暦年
+  std::string name;                 // ファイル名
+  std::size_t n_p = std::string(kParamN).size();  // 接頭辞の長さ
+  std::size_t n_s = std::string(kParamS).size();  // 接尾辞の長さ
+  DIR* dir;
+  struct dirent* ent;
+
+  try {
+    dir = opendir(kParamD);
+    if (dir == nullptr) fail("Could not open \"" + std::string(kParamD) + "\"!");
+    while ((ent = readdir(dir)) != nullptr) {
+      name = ent->d_name;
+      if (name.size() != n_p + 2 + n_s) continue;
+      if (name.compare(0, n_p, kParamN) != 0) continue;
+      if (name.compare(n_p + 2, n_s, kParamS) != 0) continue;
+      if (!isdigit(static_cast<unsigned char>(name[n_p]))
+       || !isdigit(static_cast<unsigned char>(name[n_p + 1]))) continue;
+      years.push_back(2000 + std::stoi(name.substr(n_p, 2)));
+    }
+    closedir(dir);
+    std::sort(years.begin(), years.end());
+  } catch (...) {
+    throw;
+  }
+
+  return years;
+}
+
+/*
+ * @brief      係数・ΔT ファイルの更新情報の取得
+ *             * ファイル毎の「名前:更新時刻(ナノ秒):サイズ」を連結した文字列。
+ *               （ファイルの追加・削除・更新で値が変わる）
+ *
+ * @param[in]  <none>
+ * @return     更新情報 (string)
+ */
+std::string File::get_stamp() {
+  std::vector<std::string> fs;  // ファイル名
+  std::string stamp;            // 更新情報
+  std::string yy;               // 西暦年（下2桁）
+  struct stat st;
+
+  try {
+    fs.push_back(kDeltaT);
+    for (auto year : get_years()) {
+      yy = std::to_string(year).substr(2, 2);
+      fs.push_back(kParamP + yy + kParamS);
+    }
+    for (auto& f : fs) {
+      stamp += f;
+      if (stat(f.c_str(), &st) == 0) {
+        stamp += ":" + std::to_string(
+            static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL
+          + st.st_mtim.tv_nsec);
+        stamp += ":" + std::to_string(static_cast<long long>(st.st_size));
+      }
+      stamp += ";";
     }
   } catch (...) {
     throw;
   }
+
+  return stamp;
 }
 
 }  // namespace ephemeris_jcg
@@ -1,25 +1,107 @@
 #ifndef EPHEMERIS_JCG_FILE_HPP_
 #define EPHEMERIS_JCG_FILE_HPP_
 
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>   // for EXIT_XXXX
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
-#include <tuple>
-#include <unordered_map>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
 
 namespace ephemeris_jcg {
 
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr unsigned int kNumGrp     = 7;   // 区分の数
+static constexpr unsigned int kNumQty     = 3;   // 区分あたりの値の数（最大）
+static constexpr unsigned int kNumSegMax  = 12;  // 区分あたりの適用期間の数（最大）
+static constexpr unsigned int kNumCoefMax = 30;  // 係数の数（最大）
+
+// 区分
+enum Grp : unsigned int {
+  kGrpSun = 0,  // 太陽
+  kGrpVns,      // 金星
+  kGrpMrs,      // 火星
+  kGrpJpt,      // 木星
+  kGrpSat,      // 土星
+  kGrpMon,      // 月
+  kGrpR,        // R, 黄道傾角
+};
+
+// 値（区分内の位置）
+enum Qty : unsigned int {
+  kQtyRa   = 0,  // R.A.
+  kQtyDec  = 1,  // Dec.
+  kQtyDist = 2,  // Dist.
+  kQtyHp   = 2,  // H.P.（月）
+  kQtyR    = 0,  // R（R, 黄道傾角）
+  kQtyEps  = 1,  // ε（R, 黄道傾角）
+};
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 係数（適用期間単位）
+struct Seg {
+  unsigned int a;                  // 適用期間（開始）
+  unsigned int b;                  // 適用期間（終了）
+  double c[kNumCoefMax][kNumQty];  // 係数（番号毎に値を並べる; c[番号][値]）
+  unsigned int n_c[kNumQty];       // 計算に使う係数の数（値毎; 打ち切りで減らす）
+};
+
+// 係数（区分単位）
+struct GrpParam {
+  unsigned int n_seg;              // 適用期間の数
+  unsigned int n_coef;             // 係数の数
+  Seg seg[kNumSegMax];             // 適用期間毎の係数
+};
+
+// 係数（1年分）
+// * 固定長の配列のみで構成し、読み込み後の計算でアロケーションが発生しないようにする。
+struct Param {
+  unsigned int year;               // 西暦年
+  unsigned int dlt_t;              // ΔT（TT（地球時） - UT1（世界時1））
+  GrpParam grp[kNumGrp];           // 区分毎の係数
+};
+
+// 恒星の係数（1年分; 列指向）
+// * 係数は番号毎に恒星数分ずつ連続させる。（c_ra[i * 恒星数 + 恒星の添字]）
+struct StarCat {
+  unsigned int year;               // 西暦年
+  unsigned int n_coef;             // 係数の数
+  std::vector<unsigned int> no;    // 番号
+  std::vector<std::string> name;   // 名称
+  std::vector<double> a;           // 適用期間（開始）
+  std::vector<double> b;           // 適用期間（終了）
+  std::vector<double> c_ra;        // 係数（R.A.）
+  std::vector<double> c_dec;       // 係数（Dec.）
+};
+
+// ファイルの読み込み
+// * 既定では、ファイルを開けない・内容が不正な場合にエラーを表示して終了する。
+// * 例外モード（File(true)）では、終了せずに std::runtime_error を送出する。
+//   （実行中の再読み込み（Store）用; 係数の数値の変換エラーも同様）
 class File {
+  bool thr;  // 例外モード
 
 public:
+  explicit File(bool = false);             // コンストラクタ
   unsigned int get_delta_t(unsigned int);  // 取得: ΔT
-  void get_param(
-      unsigned int, double, double,
-      std::unordered_map<std::string, std::tuple<unsigned int, unsigned int>>&,
-      std::unordered_map<std::string, std::vector<double>>&);  // 取得: 係数
+  void get_param(unsigned int, Param&);    // 取得: 係数
+  void get_star(unsigned int, StarCat&);   // 取得: 恒星の係数
+  std::vector<unsigned int> get_years();   // 取得: 係数ファイルの存在する年
+  std::string get_stamp();                 // 取得: 係数・ΔT ファイルの更新情報
+
+private:
+  void fail(const std::string&);           // エラー（終了 | 例外）
 };
 
 }  // namespace ephemeris_jcg
@@ -0,0 +1,170 @@
+#include "fix.hpp"
+
+#include "common.hpp"
+
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <iostream>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr double kPi  = atan(1.0) * 4;  // PI
+static constexpr double kD2R = kPi / 180.0;    // 度 -> ラジアン
+
+/*
+ * @brief       計算: 船位
+ *              * 船舶毎の推測位置から反復し、全船舶が収束（または失敗）するか
+ *                反復回数が最大に達するまで続ける。
+ *              * 観測の並び順は任意。（船舶毎に整列する必要は無い）
+ *
+ * @param[in]   観測 (vector<Sight>)
+ * @param[in]   推測位置: 緯度配列（°） (const double*)
+ * @param[in]   推測位置: 経度配列（°） (const double*)
+ * @param[in]   船舶数 (size_t)
+ * @param[out]  船位 (vector<Fix>; 船舶番号順)
+ * @return      <none>
+ */
+void CelFix::calc(const std::vector<Sight>& sgt, const double* lat0,
+                  const double* lon0, std::size_t n_vsl,
+                  std::vector<Fix>& fix) {
+  const std::size_t n = sgt.size();
+  std::vector<double> lat(lat0, lat0 + n_vsl);  // 緯度（°）
+  std::vector<double> lon(lon0, lon0 + n_vsl);  // 経度（°）
+  std::vector<double> sl(n_vsl);                // sin(緯度)
+  std::vector<double> cl(n_vsl);                // cos(緯度)
+  std::vector<double> n11(n_vsl);               // 正規方程式: 係数行列 (1, 1)
+  std::vector<double> n12(n_vsl);               // 正規方程式: 係数行列 (1, 2)
+  std::vector<double> n22(n_vsl);               // 正規方程式: 係数行列 (2, 2)
+  std::vector<double> b1(n_vsl);                // 正規方程式: 右辺 (1)
+  std::vector<double> b2(n_vsl);                // 正規方程式: 右辺 (2)
+  std::vector<char> act(n_vsl, 1);              // 反復中
+  std::size_t n_act = n_vsl;                    // 反復中の船舶数
+  double zn;                                    // 方位角（°）
+  double dh;                                    // 高度差（°）
+  double a1;                                    // 偏微分（緯度）
+  double a2;                                    // 偏微分（経度）
+  double det;                                   // 行列式
+  double d_lat;                                 // 緯度の修正量（°）
+  double d_lon;                                 // 経度の修正量（°）
+  unsigned int it;                              // 反復回数
+  std::size_t s;                                // loop index（観測）
+  std::size_t v;                                // loop index（船舶）
+
+  try {
+    fix.assign(n_vsl, Fix());
+    for (s = 0; s < n; ++s) {
+      if (sgt[s].vsl >= n_vsl || sgt[s].body >= kNumBody) {
+        std::cout << "[ERROR] Invalid sight #" << s << "!" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      ++fix[sgt[s].vsl].n_sight;
+    }
+    calc_pos(sgt);
+    for (v = 0; v < n_vsl; ++v) {
+      if (fix[v].n_sight < 2) {
+        act[v] = 0;
+        --n_act;
+      }
+    }
+
+    // 反復
+    for (it = 1; it <= kFixIterMax && n_act > 0; ++it) {
+      for (v = 0; v < n_vsl; ++v) {
+        sl[v]  = sin(lat[v] * kD2R);
+        cl[v]  = cos(lat[v] * kD2R);
+        n11[v] = n12[v] = n22[v] = b1[v] = b2[v] = 0.0;
+      }
+      for (s = 0; s < n; ++s) {
+        v = vsl[s];
+        if (!act[v]) continue;
+        dh = ho[s] - calc_alt_az(pos[s], sl[v], cl[v], lon[v], 1.0, limb[s], zn);
+        a1 = cos(zn * kD2R);
+        a2 = sin(zn * kD2R) * cl[v];
+        n11[v] += a1 * a1;
+        n12[v] += a1 * a2;
+        n22[v] += a2 * a2;
+        b1[v]  += a1 * dh;
+        b2[v]  += a2 * dh;
+      }
+      for (v = 0; v < n_vsl; ++v) {
+        if (!act[v]) continue;
+        det = n11[v] * n22[v] - n12[v] * n12[v];
+        if (!(det > 1.0e-9 * (n11[v] + n22[v]) * (n11[v] + n22[v]))) {
+          act[v] = 0;  // 方位の偏り（位置の線が平行）
+          --n_act;
+          continue;
+        }
+        d_lat = (n22[v] * b1[v] - n12[v] * b2[v]) / det;
+        d_lon = (n11[v] * b2[v] - n12[v] * b1[v]) / det;
+        lat[v] += d_lat;
+        lon[v] += d_lon;
+        if (lat[v] >  90.0) lat[v] =  90.0;
+        if (lat[v] < -90.0) lat[v] = -90.0;
+        while (lon[v] >   180.0) lon[v] -= 360.0;
+        while (lon[v] <= -180.0) lon[v] += 360.0;
+        fix[v].n_iter = it;
+        if (std::abs(d_lat) < kFixEps && std::abs(d_lon * cl[v]) < kFixEps) {
+          fix[v].ok = true;
+          act[v] = 0;
+          --n_act;
+        }
+      }
+    }
+
+    // 残差
+    for (v = 0; v < n_vsl; ++v) {
+      sl[v]  = sin(lat[v] * kD2R);
+      cl[v]  = cos(lat[v] * kD2R);
+      b1[v]  = 0.0;
+    }
+    for (s = 0; s < n; ++s) {
+      v = vsl[s];
+      dh = ho[s] - calc_alt_az(pos[s], sl[v], cl[v], lon[v], 1.0, limb[s], zn);
+      b1[v] += dh * dh;
+    }
+    for (v = 0; v < n_vsl; ++v) {
+      fix[v].lat = lat[v];
+      fix[v].lon = lon[v];
+      if (fix[v].n_sight > 0) fix[v].rms = sqrt(b1[v] / fix[v].n_sight) * 60.0;
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      計算: 天体位置
+ *             * 観測毎に天体の地心位置を求めて保持する。
+ *             * 直前の観測と同時刻の場合は、計算結果を使い回す。
+ *
+ * @param[in]  観測 (vector<Sight>)
+ * @return     <none>
+ */
+void CelFix::calc_pos(const std::vector<Sight>& sgt) {
+  const std::size_t n = sgt.size();
+  Result res;   // 計算結果
+  std::size_t s;
+
+  try {
+    vsl.resize(n);
+    pos.resize(n);
+    limb.resize(n);
+    ho.resize(n);
+    for (s = 0; s < n; ++s) {
+      if (s == 0 || sgt[s].ut1.tv_sec  != sgt[s - 1].ut1.tv_sec
+                 || sgt[s].ut1.tv_nsec != sgt[s - 1].ut1.tv_nsec) {
+        eph.get(ts2dt(sgt[s].ut1).year).calc(sgt[s].ut1, res);
+      }
+      vsl[s]  = sgt[s].vsl;
+      pos[s]  = get_body_pos(res, sgt[s].body);
+      limb[s] = sgt[s].limb;
+      ho[s]   = sgt[s].ho;
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,71 @@
+#ifndef EPHEMERIS_JCG_FIX_HPP_
+#define EPHEMERIS_JCG_FIX_HPP_
+
+#include "eph_jcg.hpp"
+#include "eph_year.hpp"
+#include "file.hpp"
+#include "result.hpp"
+#include "topo.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr unsigned int kFixIterMax = 10;     // 反復回数（最大）
+static constexpr double       kFixEps     = 1.0e-7; // 収束判定（°）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 天測（1観測）
+struct Sight {
+  unsigned int vsl;     // 船舶番号（0 - 船舶数-1）
+  unsigned int body;    // 天体（Grp; 太陽 - 月）
+  int limb;             // 周縁（Limb）
+  struct timespec ut1;  // 観測時刻（UT1）
+  double ho;            // 観測高度 Ho（°; 器差・眼高差・大気差を補正したもの）
+};
+
+// 船位
+struct Fix {
+  double lat;           // 緯度（°; 北緯を正）
+  double lon;           // 経度（°; 東経を正）
+  double rms;           // 残差の二乗平均平方根（′）
+  unsigned int n_sight; // 観測数
+  unsigned int n_iter;  // 反復回数
+  bool ok;              // 成否（観測数不足・方位の偏り・非収束で偽）
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 天測位置（多数の船舶; 最小二乗）
+// * 観測毎の天体位置を前計算し、全船舶を一括で反復する。
+//   （反復毎に全観測を1回走査して船舶毎の正規方程式を作り、船舶毎に解く）
+// * 修正差法: 推測位置での計算高度 Hc・方位角 Zn から
+//     Ho - Hc = cos Zn Δφ + sin Zn cos φ Δλ
+//   を最小二乗で解き、位置を更新する。（Hc は Topo と共通の calc_alt_az; 視差・視半径を含む）
+class CelFix {
+  std::vector<unsigned int> vsl;  // 観測: 船舶番号
+  std::vector<BodyPos> pos;       // 観測: 天体の地心位置
+  std::vector<int> limb;          // 観測: 周縁（Limb）
+  std::vector<double> ho;         // 観測: 観測高度（°）
+  EphYear eph;                    // 年毎の計算
+
+public:
+  void calc(const std::vector<Sight>&, const double*, const double*,
+            std::size_t, std::vector<Fix>&);  // 計算: 船位
+
+private:
+  void calc_pos(const std::vector<Sight>&);    // 計算: 天体位置
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,310 @@
+#include "pipeline.hpp"
+
+#include "common.hpp"
+#include "eph_jcg.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr char kValName[kNumVal][12] = {
+  "sun_ra",   "sun_dec",  "sun_dist",
+  "vns_ra",   "vns_dec",  "vns_dist",
+  "mrs_ra",   "mrs_dec",  "mrs_dist",
+  "jpt_ra",   "jpt_dec",  "jpt_dist",
+  "sat_ra",   "sat_dec",  "sat_dist",
+  "mon_ra",   "mon_dec",  "mon_hp",
+  "r",        "eps",
+  "sun_hg",   "vns_hg",   "mrs_hg",   "jpt_hg",   "sat_hg",   "mon_hg",
+  "sun_sd",   "vns_sd",   "mrs_sd",
+  "jpt_sd_p", "jpt_sd_e", "sat_sd_p", "sat_sd_e", "mon_sd",
+};
+static constexpr double kFmtScale = 1.0e8;  // 小数点以下の桁数（8桁）
+static constexpr double kFmtMax   = 9.0e9;  // 整数演算で整形する絶対値の上限
+
+/*
+ * @brief       整形: 整数（固定桁数; 0 埋め）
+ *
+ * @param[in]   値 (unsigned long long)
+ * @param[in]   桁数 (unsigned int)
+ * @param[ref]  出力先 (char*)
+ * @return      出力位置 (char*)
+ */
+static char* fmt_uint(unsigned long long v, unsigned int n, char* p) {
+  unsigned int i;
+
+  for (i = n; i > 0; --i) {
+    p[i - 1] = static_cast<char>('0' + v % 10);
+    v /= 10;
+  }
+
+  return p + n;
+}
+
+/*
+ * @brief       整形: 実数（小数点以下8桁）
+ *              * printf("%.8f") 相当を整数演算で行う。（範囲外は snprintf）
+ *
+ * @param[in]   値 (double)
+ * @param[ref]  出力先 (char*; 32 バイト以上)
+ * @return      出力位置 (char*)
+ */
+static char* fmt_fixed(double v, char* p) {
+  unsigned long long x;   // 値 * 10^8
+  unsigned long long ip;  // 整数部
+  unsigned int n = 1;     // 整数部の桁数
+
+  if (!std::isfinite(v) || std::abs(v) >= kFmtMax) {
+    return p + std::snprintf(p, 32, "%.8f", v);
+  }
+  if (std::signbit(v)) *p++ = '-';
+  x  = std::llround(std::abs(v) * kFmtScale);
+  ip = x / static_cast<unsigned long long>(kFmtScale);
+  while (ip >= 10) {
+    ip /= 10;
+    ++n;
+  }
+  p = fmt_uint(x / static_cast<unsigned long long>(kFmtScale), n, p);
+  *p++ = '.';
+
+  return fmt_uint(x % static_cast<unsigned long long>(kFmtScale), 8, p);
+}
+
+/*
+ * @brief  コンストラクタ
+ *
+ * @param[in]  係数・ΔT の保持 (Store&)
+ * @param[in]  計算スレッド数 (unsigned int; 0 の場合は論理 CPU 数 - 1)
+ */
+Pipeline::Pipeline(Store& st, unsigned int n_thread)
+    : st(st), n_thread(n_thread), n_out(0), n_bad(0), n_skip(0) {
+  if (this->n_thread == 0) {
+    this->n_thread = std::thread::hardware_concurrency();
+    if (this->n_thread > 1) --this->n_thread;
+    if (this->n_thread == 0) this->n_thread = 1;
+  }
+}
+
+/*
+ * @brief      実行
+ *             * 書式エラー・係数の無い年の行は出力せず、標準エラー出力に警告する。
+ *
+ * @param[in]  入力 (FILE*)
+ * @param[in]  出力 (FILE*)
+ * @return     <none>
+ */
+void Pipeline::run(std::FILE* in, std::FILE* out) {
+  BoundedQueue<PipeBatch> q_in(n_thread * 2);   // 解析 -> 計算
+  BoundedQueue<PipeBatch> q_out(n_thread * 2);  // 計算 -> 出力
+  std::vector<std::thread> ths;                 // 計算スレッド
+  std::map<std::uint64_t, PipeBatch> pend;      // 出力待ち（順序待ち）
+  std::uint64_t seq = 0;                        // 次に出力する通し番号
+  std::string hdr("ut1");                       // 見出し
+  PipeBatch b;
+  unsigned int i;
+
+  try {
+    n_out = n_bad = n_skip = 0;
+    for (i = 0; i < kNumVal; ++i) hdr += std::string(",") + kValName[i];
+    hdr += "\n";
+    std::fwrite(hdr.data(), 1, hdr.size(), out);
+
+    std::thread th_in([&]() {
+      parse(in, q_in);
+      q_in.close();
+    });
+    for (i = 0; i < n_thread; ++i) {
+      ths.emplace_back([&]() { eval(q_in, q_out); });
+    }
+    std::thread th_end([&]() {
+      for (auto& th : ths) th.join();
+      q_out.close();
+    });
+
+    // 出力（入力順）
+    while (q_out.pop(b)) {
+      pend.emplace(b.seq, std::move(b));
+      for (auto it = pend.find(seq); it != pend.end(); it = pend.find(++seq)) {
+        PipeBatch& c = it->second;
+        std::fwrite(c.out.data(), 1, c.out.size(), out);
+        for (auto l : c.bad) {
+          std::cerr << "[WARNING] Line " << l << ": invalid format!" << std::endl;
+        }
+        for (auto l : c.skip) {
+          std::cerr << "[WARNING] Line " << l << ": out of range!" << std::endl;
+        }
+        n_out  += c.ts.size() - c.skip.size();
+        n_bad  += c.bad.size();
+        n_skip += c.skip.size();
+        pend.erase(it);
+      }
+    }
+    th_in.join();
+    th_end.join();
+    std::fflush(out);
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief   取得: 出力件数
+ *
+ * @param   <none>
+ * @return  出力件数 (uint64_t)
+ */
+std::uint64_t Pipeline::get_n_out() const {
+  return n_out;
+}
+
+/*
+ * @brief   取得: 書式エラー件数
+ *
+ * @param   <none>
+ * @return  書式エラー件数 (uint64_t)
+ */
+std::uint64_t Pipeline::get_n_bad() const {
+  return n_bad;
+}
+
+/*
+ * @brief   取得: 係数の無い年の件数
+ *
+ * @param   <none>
+ * @return  係数の無い年の件数 (uint64_t)
+ */
+std::uint64_t Pipeline::get_n_skip() const {
+  return n_skip;
+}
+
+/*
+ * @brief       解析
+ *              * 大きな単位で読み込んで行に分割し、kPipeLines 行毎にバッチとして送る。
+ *              * 行頭・行末の空白（CR を含む）は除く。
+ *
+ * @param[in]   入力 (FILE*)
+ * @param[ref]  送り先 (BoundedQueue<PipeBatch>)
+ * @return      <none>
+ */
+void Pipeline::parse(std::FILE* in, BoundedQueue<PipeBatch>& q) {
+  std::vector<char> buf(kPipeRead);  // 読み込みバッファ
+  std::size_t n_buf = 0;             // バッファ内の有効バイト数
+  std::size_t n_rd;                  // 読み込みバイト数
+  std::uint64_t ln = 0;              // 行番号
+  std::uint64_t seq = 0;             // 通し番号
+  std::size_t n_line = 0;            // バッチ内の行数
+  struct timespec ts;
+  PipeBatch b;
+  bool eof = false;
+
+  b.seq = seq++;
+  while (!eof) {
+    n_rd = std::fread(buf.data() + n_buf, 1, buf.size() - n_buf, in);
+    n_buf += n_rd;
+    eof = (n_rd == 0);
+    const char* p   = buf.data();
+    const char* end = buf.data() + n_buf;
+    while (p < end) {
+      const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      if (nl == nullptr) {
+        if (!eof) break;  // 次の読み込みへ持ち越し
+        nl = end;
+      }
+      const char* s = p;
+      const char* e = nl;
+      p = (nl < end) ? nl + 1 : end;
+      ++ln;
+      while (s < e && (*s == ' ' || *s == '\t')) ++s;
+      while (e > s && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r')) --e;
+      if (s == e || *s == '#') continue;
+      if (parse_time(s, e - s, ts)) {
+        b.ts.push_back(ts);
+        b.line.push_back(ln);
+      } else {
+        b.bad.push_back(ln);
+      }
+      if (++n_line == kPipeLines) {
+        if (!q.push(std::move(b))) return;
+        b = PipeBatch();
+        b.seq = seq++;
+        n_line = 0;
+      }
+    }
+    n_buf = end - p;
+    std::memmove(buf.data(), p, n_buf);
+    if (n_buf == buf.size()) buf.resize(buf.size() * 2);  // 1行がバッファを超える
+  }
+  if (n_line > 0) q.push(std::move(b));
+}
+
+/*
+ * @brief       計算・整形
+ *              * バッチ毎に Store の読み取りを保持し、年が変わるまで同じ係数を使う。
+ *              * 時刻はバッチ毎に ts2tf で一括変換してから計算する。
+ *                （年月日時分秒への変換は出力の整形にのみ使用する）
+ *
+ * @param[ref]  受け取り元 (BoundedQueue<PipeBatch>)
+ * @param[ref]  送り先 (BoundedQueue<PipeBatch>)
+ * @return      <none>
+ */
+void Pipeline::eval(BoundedQueue<PipeBatch>& q_in, BoundedQueue<PipeBatch>& q_out) {
+  std::unique_ptr<EphJcg> o_e;  // 計算
+  Result res;                   // 計算結果
+  DateTime dt;                  // UT1（年月日時分秒）
+  std::vector<int> y;           // 西暦年
+  std::vector<unsigned int> t;  // 通日 T
+  std::vector<double> f;        // UT1 の日の端数 F
+  PipeBatch b;
+  char ln[64 + 32 * kNumVal];   // 1行分
+  char* p;
+  std::size_t i;
+  unsigned int v;
+
+  while (q_in.pop(b)) {
+    Store::Reader rd(st);
+    const Param* prm = nullptr;
+    b.out.reserve(b.ts.size() * (32 + 14 * kNumVal));
+    y.resize(b.ts.size());
+    t.resize(b.ts.size());
+    f.resize(b.ts.size());
+    ts2tf(b.ts.data(), b.ts.size(), y.data(), t.data(), f.data());
+    for (i = 0; i < b.ts.size(); ++i) {
+      if (prm == nullptr || static_cast<int>(prm->year) != y[i]) {
+        prm = rd.find(y[i]);
+        if (prm == nullptr) {
+          b.skip.push_back(b.line[i]);
+          continue;
+        }
+        o_e.reset(new EphJcg(*prm));
+      }
+      o_e->calc(y[i], t[i], f[i], res);
+      dt = ts2dt(b.ts[i]);
+      p = ln;
+      p = fmt_uint(dt.year, 4, p);   *p++ = '-';
+      p = fmt_uint(dt.month, 2, p);  *p++ = '-';
+      p = fmt_uint(dt.day, 2, p);    *p++ = ' ';
+      p = fmt_uint(dt.hour, 2, p);   *p++ = ':';
+      p = fmt_uint(dt.min, 2, p);    *p++ = ':';
+      p = fmt_uint(dt.sec, 2, p);    *p++ = '.';
+      p = fmt_uint(dt.nsec, 9, p);
+      for (v = 0; v < kNumVal; ++v) {
+        *p++ = ',';
+        p = fmt_fixed(get_val(res, v), p);
+      }
+      *p++ = '\n';
+      b.out.append(ln, p - ln);
+    }
+    o_e.reset();
+    if (!q_out.push(std::move(b))) return;
+    b = PipeBatch();
+  }
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,111 @@
+#ifndef EPHEMERIS_JCG_PIPELINE_HPP_
+#define EPHEMERIS_JCG_PIPELINE_HPP_
+
+#include "result.hpp"
+#include "store.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr std::size_t kPipeLines = 4096;     // バッチあたりの行数
+static constexpr std::size_t kPipeRead  = 1 << 20;  // 読み込み単位（バイト）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// バッチ（連続する行の単位; 段間で受け渡す）
+struct PipeBatch {
+  std::uint64_t seq;                       // 通し番号（出力順）
+  std::vector<struct timespec> ts;         // 時刻（UT1）
+  std::vector<std::uint64_t> line;         // 時刻の行番号
+  std::vector<std::uint64_t> bad;          // 書式エラーの行番号
+  std::vector<std::uint64_t> skip;         // 係数の無い年の行番号
+  std::string out;                         // 出力（CSV）
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 容量制限付きキュー（複数スレッド間）
+// * 満杯なら push が、空なら pop が待つ。
+// * close 後の push は失敗し、pop は空になった時点で失敗する。
+template <class T>
+class BoundedQueue {
+  std::deque<T> q;                // 要素
+  std::size_t cap;                // 容量
+  bool closed;                    // 終了
+  std::mutex mtx;                 // 排他
+  std::condition_variable cv_put; // 空き待ち
+  std::condition_variable cv_get; // 要素待ち
+
+public:
+  explicit BoundedQueue(std::size_t cap) : cap(cap), closed(false) {}
+
+  bool push(T&& v) {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv_put.wait(lk, [this]() { return closed || q.size() < cap; });
+    if (closed) return false;
+    q.push_back(std::move(v));
+    cv_get.notify_one();
+    return true;
+  }
+
+  bool pop(T& v) {
+    std::unique_lock<std::mutex> lk(mtx);
+    cv_get.wait(lk, [this]() { return closed || !q.empty(); });
+    if (q.empty()) return false;
+    v = std::move(q.front());
+    q.pop_front();
+    cv_put.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lk(mtx);
+    closed = true;
+    cv_put.notify_all();
+    cv_get.notify_all();
+  }
+};
+
+// 一括計算（ファイル入力; 解析 -> 計算 -> 出力）
+// * 入力は1行1時刻。（23桁の数字 | ISO-8601; 空行・'#' で始まる行は無視）
+// * 解析（1スレッド）、計算・整形（複数スレッド）、出力（呼び出しスレッド）を
+//   容量制限付きキューで接続し、並行に処理する。（出力は入力順）
+// * 出力は CSV（UT1, Result の各値（Val 順））。
+class Pipeline {
+  Store& st;                 // 係数・ΔT の保持
+  unsigned int n_thread;     // 計算スレッド数
+  std::uint64_t n_out;       // 出力件数
+  std::uint64_t n_bad;       // 書式エラー件数
+  std::uint64_t n_skip;      // 係数の無い年の件数
+
+public:
+  Pipeline(Store&, unsigned int = 0);  // コンストラクタ
+  void run(std::FILE*, std::FILE*);    // 実行
+  std::uint64_t get_n_out() const;     // 取得: 出力件数
+  std::uint64_t get_n_bad() const;     // 取得: 書式エラー件数
+  std::uint64_t get_n_skip() const;    // 取得: 係数の無い年の件数
+
+private:
+  void parse(std::FILE*, BoundedQueue<PipeBatch>&);                // 解析
+  void eval(BoundedQueue<PipeBatch>&, BoundedQueue<PipeBatch>&);   // 計算・整形
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
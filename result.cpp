@@ -0,0 +1,264 @@
+#include "result.hpp"
+
+namespace ephemeris_jcg {
+
+// 値（Val） -> Result メンバ
+static double Result::* const kValPtr[kNumVal] = {
+  &Result::sun_ra,   &Result::sun_dec,  &Result::sun_dist,
+  &Result::vns_ra,   &Result::vns_dec,  &Result::vns_dist,
+  &Result::mrs_ra,   &Result::mrs_dec,  &Result::mrs_dist,
+  &Result::jpt_ra,   &Result::jpt_dec,  &Result::jpt_dist,
+  &Result::sat_ra,   &Result::sat_dec,  &Result::sat_dist,
+  &Result::mon_ra,   &Result::mon_dec,  &Result::mon_hp,
+  &Result::r,        &Result::eps,
+  &Result::sun_hg,   &Result::vns_hg,   &Result::mrs_hg,
+  &Result::jpt_hg,   &Result::sat_hg,   &Result::mon_hg,
+  &Result::sun_sd,   &Result::vns_sd,   &Result::mrs_sd,
+  &Result::jpt_sd_p, &Result::jpt_sd_e,
+  &Result::sat_sd_p, &Result::sat_sd_e,
+  &Result::mon_sd,
+};
+
+/*
+ * @brief      判定: 単精度で保持可能な値
+ *             * Dist., 視半径
+ *
+ * @param[in]  値 (unsigned int; Val)
+ * @return     true: 単精度で保持可能, false: 倍精度が必要
+ */
+bool is_val_f32(unsigned int v) {
+  return v == kValSunDist || v == kValVnsDist || v == kValMrsDist ||
+         v == kValJptDist || v == kValSatDist ||
+         (kValSunSd <= v && v <= kValMonSd);
+}
+
+/*
+ * @brief      取得: 値（Val 指定）
+ *
+ * @param[in]  計算結果 (Result)
+ * @param[in]  値 (unsigned int; Val)
+ * @return     値 (double)
+ */
+double get_val(const Result& res, unsigned int v) {
+  return res.*kValPtr[v];
+}
+
+/*
+ * @brief       設定: 値（Val 指定）
+ *
+ * @param[ref]  計算結果 (Result)
+ * @param[in]   値 (unsigned int; Val)
+ * @param[in]   値 (double)
+ * @return      <none>
+ */
+void set_val(Result& res, unsigned int v, double d) {
+  res.*kValPtr[v] = d;
+}
+
+/*
+ * @brief      変換: Result -> ResultF
+ *             * Dist., 視半径は単精度に丸める。
+ *
+ * @param[in]  計算結果 (Result)
+ * @return     計算結果（単精度併用） (ResultF)
+ */
+ResultF to_result_f(const Result& res) {
+  ResultF rf;
+
+  rf.sun_ra   = res.sun_ra;
+  rf.sun_dec  = res.sun_dec;
+  rf.vns_ra   = res.vns_ra;
+  rf.vns_dec  = res.vns_dec;
+  rf.mrs_ra   = res.mrs_ra;
+  rf.mrs_dec  = res.mrs_dec;
+  rf.jpt_ra   = res.jpt_ra;
+  rf.jpt_dec  = res.jpt_dec;
+  rf.sat_ra   = res.sat_ra;
+  rf.sat_dec  = res.sat_dec;
+  rf.mon_ra   = res.mon_ra;
+  rf.mon_dec  = res.mon_dec;
+  rf.mon_hp   = res.mon_hp;
+  rf.r        = res.r;
+  rf.eps      = res.eps;
+  rf.sun_hg   = res.sun_hg;
+  rf.vns_hg   = res.vns_hg;
+  rf.mrs_hg   = res.mrs_hg;
+  rf.jpt_hg   = res.jpt_hg;
+  rf.sat_hg   = res.sat_hg;
+  rf.mon_hg   = res.mon_hg;
+  rf.sun_dist = static_cast<float>(res.sun_dist);
+  rf.vns_dist = static_cast<float>(res.vns_dist);
+  rf.mrs_dist = static_cast<float>(res.mrs_dist);
+  rf.jpt_dist = static_cast<float>(res.jpt_dist);
+  rf.sat_dist = static_cast<float>(res.sat_dist);
+  rf.sun_sd   = static_cast<float>(res.sun_sd);
+  rf.vns_sd   = static_cast<float>(res.vns_sd);
+  rf.mrs_sd   = static_cast<float>(res.mrs_sd);
+  rf.jpt_sd_p = static_cast<float>(res.jpt_sd_p);
+  rf.jpt_sd_e = static_cast<float>(res.jpt_sd_e);
+  rf.sat_sd_p = static_cast<float>(res.sat_sd_p);
+  rf.sat_sd_e = static_cast<float>(res.sat_sd_e);
+  rf.mon_sd   = static_cast<float>(res.mon_sd);
+
+  return rf;
+}
+
+/*
+ * @brief      変換: ResultF -> Result
+ *
+ * @param[in]  計算結果（単精度併用） (ResultF)
+ * @return     計算結果 (Result)
+ */
+Result to_result(const ResultF& rf) {
+  Result res;
+
+  res.sun_ra   = rf.sun_ra;
+  res.sun_dec  = rf.sun_dec;
+  res.sun_dist = rf.sun_dist;
+  res.vns_ra   = rf.vns_ra;
+  res.vns_dec  = rf.vns_dec;
+  res.vns_dist = rf.vns_dist;
+  res.mrs_ra   = rf.mrs_ra;
+  res.mrs_dec  = rf.mrs_dec;
+  res.mrs_dist = rf.mrs_dist;
+  res.jpt_ra   = rf.jpt_ra;
+  res.jpt_dec  = rf.jpt_dec;
+  res.jpt_dist = rf.jpt_dist;
+  res.sat_ra   = rf.sat_ra;
+  res.sat_dec  = rf.sat_dec;
+  res.sat_dist = rf.sat_dist;
+  res.mon_ra   = rf.mon_ra;
+  res.mon_dec  = rf.mon_dec;
+  res.mon_hp   = rf.mon_hp;
+  res.r        = rf.r;
+  res.eps      = rf.eps;
+  res.sun_hg   = rf.sun_hg;
+  res.vns_hg   = rf.vns_hg;
+  res.mrs_hg   = rf.mrs_hg;
+  res.jpt_hg   = rf.jpt_hg;
+  res.sat_hg   = rf.sat_hg;
+  res.mon_hg   = rf.mon_hg;
+  res.sun_sd   = rf.sun_sd;
+  res.vns_sd   = rf.vns_sd;
+  res.mrs_sd   = rf.mrs_sd;
+  res.jpt_sd_p = rf.jpt_sd_p;
+  res.jpt_sd_e = rf.jpt_sd_e;
+  res.sat_sd_p = rf.sat_sd_p;
+  res.sat_sd_e = rf.sat_sd_e;
+  res.mon_sd   = rf.mon_sd;
+
+  return res;
+}
+
+/*
+ * @brief      コンストラクタ
+ *
+ * @param[in]  単精度モード (bool)
+ */
+ResultCols::ResultCols(bool f32) : f32(f32), n(0) {}
+
+/*
+ * @brief      件数変更
+ *
+ * @param[in]  件数 (size_t)
+ * @return     <none>
+ */
+void ResultCols::resize(std::size_t n) {
+  unsigned int v;
+
+  try {
+    for (v = 0; v < kNumVal; ++v) {
+      if (f32 && is_val_f32(v)) {
+        col_f[v].resize(n);
+      } else {
+        col_d[v].resize(n);
+      }
+    }
+    this->n = n;
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief   件数
+ *
+ * @param   <none>
+ * @return  件数 (size_t)
+ */
+std::size_t ResultCols::size() const {
+  return n;
+}
+
+/*
+ * @brief   単精度モード判定
+ *
+ * @param   <none>
+ * @return  true: 単精度モード, false: 倍精度モード
+ */
+bool ResultCols::is_f32() const {
+  return f32;
+}
+
+/*
+ * @brief      設定: 1件分
+ *
+ * @param[in]  位置 (size_t)
+ * @param[in]  計算結果 (Result)
+ * @return     <none>
+ */
+void ResultCols::set(std::size_t i, const Result& res) {
+  unsigned int v;
+
+  for (v = 0; v < kNumVal; ++v) {
+    if (f32 && is_val_f32(v)) {
+      col_f[v][i] = static_cast<float>(res.*kValPtr[v]);
+    } else {
+      col_d[v][i] = res.*kValPtr[v];
+    }
+  }
+}
+
+/*
+ * @brief       取得: 1件分
+ *
+ * @param[in]   位置 (size_t)
+ * @param[ref]  計算結果 (Result)
+ * @return      <none>
+ */
+void ResultCols::get(std::size_t i, Result& res) const {
+  unsigned int v;
+
+  for (v = 0; v < kNumVal; ++v) {
+    if (f32 && is_val_f32(v)) {
+      res.*kValPtr[v] = col_f[v][i];
+    } else {
+      res.*kValPtr[v] = col_d[v][i];
+    }
+  }
+}
+
+/*
+ * @brief      列（double）
+ *
+ * @param[in]  値 (unsigned int; Val)
+ * @return     列の先頭 (const double*; float で保持している場合 nullptr)
+ */
+const double* ResultCols::col(unsigned int v) const {
+  if (f32 && is_val_f32(v)) return nullptr;
+  return col_d[v].data();
+}
+
+/*
+ * @brief      列（float）
+ *
+ * @param[in]  値 (unsigned int; Val)
+ * @return     列の先頭 (const float*; double で保持している場合 nullptr)
+ */
+const float* ResultCols::col_f32(unsigned int v) const {
+  if (!f32 || !is_val_f32(v)) return nullptr;
+  return col_f[v].data();
+}
+
+}  // namespace ephemeris_jcg
+
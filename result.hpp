@@ -0,0 +1,180 @@
+#ifndef EPHEMERIS_JCG_RESULT_HPP_
+#define EPHEMERIS_JCG_RESULT_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+// 値（計算結果の並び順）
+enum Val : unsigned int {
+  kValSunRa = 0,  // SUN R.A.
+  kValSunDec,     // SUN Dec.
+  kValSunDist,    // SUN Dist.
+  kValVnsRa,      // VNS R.A.
+  kValVnsDec,     // VNS Dec.
+  kValVnsDist,    // VNS Dist.
+  kValMrsRa,      // MRS R.A.
+  kValMrsDec,     // MRS Dec.
+  kValMrsDist,    // MRS Dist.
+  kValJptRa,      // JPT R.A.
+  kValJptDec,     // JPT Dec.
+  kValJptDist,    // JPT Dist.
+  kValSatRa,      // SAT R.A.
+  kValSatDec,     // SAT Dec.
+  kValSatDist,    // SAT Dist.
+  kValMonRa,      // MON R.A.
+  kValMonDec,     // MON Dec.
+  kValMonHp,      // MON H.P.
+  kValR,          // R
+  kValEps,        // ε
+  kValSunHg,      // SUN グリニッジ時角
+  kValVnsHg,      // VNS グリニッジ時角
+  kValMrsHg,      // MRS グリニッジ時角
+  kValJptHg,      // JPT グリニッジ時角
+  kValSatHg,      // SAT グリニッジ時角
+  kValMonHg,      // MON グリニッジ時角
+  kValSunSd,      // SUN 視半径
+  kValVnsSd,      // VNS 視半径
+  kValMrsSd,      // MRS 視半径
+  kValJptSdP,     // JPT 視半径（極半径）
+  kValJptSdE,     // JPT 視半径（赤道半径）
+  kValSatSdP,     // SAT 視半径（極半径）
+  kValSatSdE,     // SAT 視半径（赤道半径）
+  kValMonSd,      // MON 視半径
+  kNumVal,        // 値の数
+};
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 計算結果（1時刻分）
+struct Result {
+  double sun_ra;            // SUN R.A.
+  double sun_dec;           // SUN Dec.
+  double sun_dist;          // SUN Dist.
+  double vns_ra;            // VNS R.A.
+  double vns_dec;           // VNS Dec.
+  double vns_dist;          // VNS Dist.
+  double mrs_ra;            // MRS R.A.
+  double mrs_dec;           // MRS Dec.
+  double mrs_dist;          // MRS Dist.
+  double jpt_ra;            // JPT R.A.
+  double jpt_dec;           // JPT Dec.
+  double jpt_dist;          // JPT Dist.
+  double sat_ra;            // SAT R.A.
+  double sat_dec;           // SAT Dec.
+  double sat_dist;          // SAT Dist.
+  double mon_ra;            // MON R.A.
+  double mon_dec;           // MON Dec.
+  double mon_hp;            // MON H.P.
+  double r;                 // R
+  double eps;               // ε
+  double sun_hg;            // SUN グリニッジ時角
+  double vns_hg;            // VNS グリニッジ時角
+  double mrs_hg;            // MRS グリニッジ時角
+  double jpt_hg;            // JPT グリニッジ時角
+  double sat_hg;            // SAT グリニッジ時角
+  double mon_hg;            // MON グリニッジ時角
+  double sun_sd;            // SUN 視半径
+  double vns_sd;            // VNS 視半径
+  double mrs_sd;            // MRS 視半径
+  double jpt_sd_p;          // JPT 視半径（極半径）
+  double jpt_sd_e;          // JPT 視半径（赤道半径）
+  double sat_sd_p;          // SAT 視半径（極半径）
+  double sat_sd_e;          // SAT 視半径（赤道半径）
+  double mon_sd;            // MON 視半径
+};
+
+// 計算結果（1時刻分; 単精度併用）
+// * Dist., 視半径のみ float で保持する。（それ以外は double）
+// * float の相対誤差は 2^-24 (約 6.0e-8) 以下であり、
+//     Dist.  : 最大約 11 AU（土星）で 6.6e-7 AU 以下（係数の桁 1e-6 AU 未満）
+//     視半径 : 最大約 33 ″（金星）・16.8 ′（月）で 2e-6 ″・1e-6 ′ 以下
+//   の誤差となる。
+// * サイズは 224 バイト（値 220 バイト + 境界調整）で、 Result（272 バイト）の
+//   約 8 割。（半分にはならない; 角度は最大 24 h・360° で float の誤差が
+//   1.4e-6 h・2.1e-5 ° となり、係数の桁（1e-6 h・1e-5 °）を保てないので double のまま）
+//   ResultCols の単精度モードも、1時刻あたり 272 バイトが 220 バイトとなる。
+struct ResultF {
+  double sun_ra;            // SUN R.A.
+  double sun_dec;           // SUN Dec.
+  double vns_ra;            // VNS R.A.
+  double vns_dec;           // VNS Dec.
+  double mrs_ra;            // MRS R.A.
+  double mrs_dec;           // MRS Dec.
+  double jpt_ra;            // JPT R.A.
+  double jpt_dec;           // JPT Dec.
+  double sat_ra;            // SAT R.A.
+  double sat_dec;           // SAT Dec.
+  double mon_ra;            // MON R.A.
+  double mon_dec;           // MON Dec.
+  double mon_hp;            // MON H.P.
+  double r;                 // R
+  double eps;               // ε
+  double sun_hg;            // SUN グリニッジ時角
+  double vns_hg;            // VNS グリニッジ時角
+  double mrs_hg;            // MRS グリニッジ時角
+  double jpt_hg;            // JPT グリニッジ時角
+  double sat_hg;            // SAT グリニッジ時角
+  double mon_hg;            // MON グリニッジ時角
+  float  sun_dist;          // SUN Dist.
+  float  vns_dist;          // VNS Dist.
+  float  mrs_dist;          // MRS Dist.
+  float  jpt_dist;          // JPT Dist.
+  float  sat_dist;          // SAT Dist.
+  float  sun_sd;            // SUN 視半径
+  float  vns_sd;            // VNS 視半径
+  float  mrs_sd;            // MRS 視半径
+  float  jpt_sd_p;          // JPT 視半径（極半径）
+  float  jpt_sd_e;          // JPT 視半径（赤道半径）
+  float  sat_sd_p;          // SAT 視半径（極半径）
+  float  sat_sd_e;          // SAT 視半径（赤道半径）
+  float  mon_sd;            // MON 視半径
+};
+
+static_assert(std::is_trivially_copyable<Result>::value,
+              "Result must be trivially copyable");
+static_assert(std::is_trivially_copyable<ResultF>::value,
+              "ResultF must be trivially copyable");
+
+// -------------------------------------
+//   Functions
+// -------------------------------------
+bool is_val_f32(unsigned int);                // 判定: 単精度で保持可能な値
+double get_val(const Result&, unsigned int);  // 取得: 値（Val 指定）
+void set_val(Result&, unsigned int, double);  // 設定: 値（Val 指定）
+ResultF to_result_f(const Result&);           // 変換: Result -> ResultF
+Result to_result(const ResultF&);             // 変換: ResultF -> Result
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 計算結果（列指向; 多数の時刻分）
+// * 値毎に連続した配列で保持する。
+// * 単精度モードでは、 is_val_f32 が真の値（Dist., 視半径）を float で保持する。
+class ResultCols {
+  bool f32;                              // 単精度モード
+  std::size_t n;                         // 件数
+  std::vector<double> col_d[kNumVal];    // 列（double）
+  std::vector<float>  col_f[kNumVal];    // 列（float; 単精度モードのみ）
+
+public:
+  explicit ResultCols(bool = false);     // コンストラクタ
+  void resize(std::size_t);              // 件数変更
+  std::size_t size() const;              // 件数
+  bool is_f32() const;                   // 単精度モード判定
+  void set(std::size_t, const Result&);  // 設定: 1件分
+  void get(std::size_t, Result&) const;  // 取得: 1件分
+  const double* col(unsigned int) const;      // 列（double; float 保持の場合 nullptr）
+  const float*  col_f32(unsigned int) const;  // 列（float; double 保持の場合 nullptr）
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
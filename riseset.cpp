@@ -0,0 +1,281 @@
+#include "riseset.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr double       kPi     = atan(1.0) * 4;  // PI
+static constexpr double       kD2R    = kPi / 180.0;    // 度 -> ラジアン
+static constexpr double       kR2D    = 180.0 / kPi;    // ラジアン -> 度
+static constexpr double       kHp0    = 8.794143;       // 1 AU での地平視差 (″)
+static constexpr double       kRefr   = 34.0 / 60.0;    // 地平線での大気差 (°)
+static constexpr long long    kStep   = 3600;           // 節点の間隔 (秒)
+static constexpr double       kTol    = 0.1;            // 時刻の許容誤差 (秒)
+static constexpr unsigned int kMaxIt  = 40;             // 反復回数の上限
+static constexpr unsigned int kNumLvl = kNumEvt / 2;    // 基準高度の数
+
+// 節点の値
+enum Nv : unsigned int {
+  kNvSunDec = 0,  // 赤緯（太陽; °）
+  kNvSunGha,      // グリニッジ時角（太陽; °; 連続）
+  kNvSunHp,       // 地平視差（太陽; °）
+  kNvSunSd,       // 視半径（太陽; °）
+  kNvMonDec,      // 赤緯（月; °）
+  kNvMonGha,      // グリニッジ時角（月; °; 連続）
+  kNvMonHp,       // 地平視差（月; °）
+  kNvMonSd,       // 視半径（月; °）
+  kNumNv,         // 節点の値の数
+};
+
+// 基準高度（Evt / 2 毎）: 天体, 高度（°; 出没は NAN とし視半径・視差から計算）
+static constexpr unsigned int kLvlBody[kNumLvl] = {
+  kGrpSun, kGrpSun, kGrpSun, kGrpSun, kGrpMon};
+static constexpr double       kLvlAlt[kNumLvl]  = {
+  NAN, -6.0, -12.0, -18.0, NAN};
+
+/*
+ * @brief  コンストラクタ
+ *
+ * @param[in]  緯度配列（°; 北緯を正） (const double*)
+ * @param[in]  経度配列（°; 東経を正） (const double*)
+ * @param[in]  観測地点数 (size_t)
+ */
+RiseSet::RiseSet(const double* lat, const double* lon, std::size_t n)
+    : sin_lat(n), cos_lat(n), lon(lon, lon + n) {
+  std::size_t i;
+
+  try {
+    for (i = 0; i < n; ++i) {
+      sin_lat[i] = sin(lat[i] * kD2R);
+      cos_lat[i] = cos(lat[i] * kD2R);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief   観測地点数
+ *
+ * @param   <none>
+ * @return  観測地点数 (size_t)
+ */
+std::size_t RiseSet::size() const {
+  return lon.size();
+}
+
+/*
+ * @brief       計算: 現象・期間
+ *              * 期間中の全観測地点の出没・薄明の時刻と、太陽・月が地平線上に
+ *                ある期間を求める。
+ *              * 出没は中心の高度が -(34′+ 視半径) + 地平視差 となる時刻、
+ *                薄明は太陽の中心の高度が -6°, -12°, -18° となる時刻とする。
+ *              * 現象は観測地点・時刻順に並べる。
+ *
+ * @param[in]   開始時刻（UT1） (timespec)
+ * @param[in]   日数 (unsigned int)
+ * @param[ref]  現象一覧 (vector<Event>)
+ * @param[ref]  期間一覧 (vector<Window>)
+ * @return      <none>
+ */
+void RiseSet::calc(struct timespec t0, unsigned int n_day,
+                   std::vector<Event>& evts, std::vector<Window>& wins) {
+  const std::size_t nn = 24 * static_cast<std::size_t>(n_day) + 1;
+  double v[kNumNv];   // 補間値
+  double a;           // 挟み込み: 始点
+  double b;           // 挟み込み: 終点
+  double c;           // 挟み込み: 新しい点
+  double ea;          // 挟み込み: 始点の値
+  double eb;          // 挟み込み: 終点の値
+  double ec;          // 挟み込み: 新しい点の値
+  double e0;          // 直前の節点の値
+  double e1;          // 節点の値
+  double t_w;         // 期間の開始
+  std::size_t i;
+  std::size_t k;
+  unsigned int lvl;
+  unsigned int it;
+
+  try {
+    evts.clear();
+    wins.clear();
+    if (n_day == 0) return;
+    calc_node(t0, n_day);
+    for (i = 0; i < size(); ++i) {
+      for (lvl = 0; lvl < kNumLvl; ++lvl) {
+        bool win = std::isnan(kLvlAlt[lvl]);  // 出没（期間を求める）
+        e0  = calc_e(lvl, i, &v_n[0]);
+        t_w = t_n[0];
+        for (k = 1; k < nn; ++k) {
+          e1 = calc_e(lvl, i, &v_n[k * kNumNv]);
+          if ((e0 < 0.0) != (e1 < 0.0)) {
+            // Illinois 法で時刻を求める
+            a  = t_n[k - 1];
+            b  = t_n[k];
+            ea = e0;
+            eb = e1;
+            for (it = 0; it < kMaxIt && std::fabs(b - a) > kTol; ++it) {
+              c = b - eb * (b - a) / (eb - ea);
+              calc_intp(c, v);
+              ec = calc_e(lvl, i, v);
+              if ((ec < 0.0) != (eb < 0.0)) {
+                a  = b;
+                ea = eb;
+              } else {
+                ea *= 0.5;
+              }
+              b  = c;
+              eb = ec;
+            }
+            evts.push_back({static_cast<unsigned int>(i),
+                            lvl * 2 + (e1 < 0.0 ? 1 : 0), b});
+            if (win) {
+              if (e1 < 0.0) {
+                wins.push_back({static_cast<unsigned int>(i),
+                                kLvlBody[lvl], t_w, b});
+              } else {
+                t_w = b;
+              }
+            }
+          }
+          e0 = e1;
+        }
+        if (win && e0 >= 0.0) {
+          wins.push_back({static_cast<unsigned int>(i),
+                          kLvlBody[lvl], t_w, t_n[nn - 1]});
+        }
+      }
+    }
+    std::stable_sort(evts.begin(), evts.end(),
+                     [](const Event& x, const Event& y) {
+                       return x.loc != y.loc ? x.loc < y.loc : x.t < y.t;
+                     });
+  } catch (...) {
+    throw;
+  }
+}
+
+// -------------------------------------
+// 以下、 private functions
+// -------------------------------------
+
+/*
+ * @brief      計算: 節点
+ *             * 開始時刻から 1 時間毎に太陽・月の位置を計算する。
+ *               （最後の節点は、翌年の係数を要しないよう終了時刻の 1 ms 前とする）
+ *             * グリニッジ時角は、節点間で連続となるよう 360° の整数倍を加減する。
+ *
+ * @param[in]  開始時刻（UT1） (timespec)
+ * @param[in]  日数 (unsigned int)
+ * @return     <none>
+ */
+void RiseSet::calc_node(struct timespec t0, unsigned int n_day) {
+  const std::size_t nn = 24 * static_cast<std::size_t>(n_day) + 1;
+  struct timespec ts;
+  Result res;
+  double* v;
+  std::size_t k;
+
+  try {
+    t_n.resize(nn);
+    v_n.resize(nn * kNumNv);
+    for (k = 0; k < nn; ++k) {
+      ts.tv_sec  = t0.tv_sec + kStep * static_cast<long long>(k);
+      ts.tv_nsec = t0.tv_nsec;
+      if (k == nn - 1) {
+        ts.tv_sec  -= 1;
+        ts.tv_nsec += 999000000;
+        if (ts.tv_nsec >= 1000000000) {
+          ts.tv_sec  += 1;
+          ts.tv_nsec -= 1000000000;
+        }
+      }
+      eph.get(ts2dt(ts).year).calc(ts, res);
+      t_n[k] = ts.tv_sec + ts.tv_nsec * 1.0e-9;
+      v = &v_n[k * kNumNv];
+      v[kNvSunDec] = res.sun_dec;
+      v[kNvSunGha] = res.sun_hg * 15.0;
+      v[kNvSunHp]  = kHp0 / 3600.0 / res.sun_dist;
+      v[kNvSunSd]  = res.sun_sd / 60.0;
+      v[kNvMonDec] = res.mon_dec;
+      v[kNvMonGha] = res.mon_hg * 15.0;
+      v[kNvMonHp]  = res.mon_hp;
+      v[kNvMonSd]  = res.mon_sd / 60.0;
+      if (k > 0) {
+        const double* p = &v_n[(k - 1) * kNumNv];
+        while (v[kNvSunGha] - p[kNvSunGha] >  180.0) v[kNvSunGha] -= 360.0;
+        while (v[kNvSunGha] - p[kNvSunGha] < -180.0) v[kNvSunGha] += 360.0;
+        while (v[kNvMonGha] - p[kNvMonGha] >  180.0) v[kNvMonGha] -= 360.0;
+        while (v[kNvMonGha] - p[kNvMonGha] < -180.0) v[kNvMonGha] += 360.0;
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算: 補間
+ *              * 時刻に最も近い 3 節点による2次（Lagrange）補間
+ *
+ * @param[in]   時刻（UT1; 秒） (double)
+ * @param[out]  補間値 (double*; kNumNv 個)
+ * @return      <none>
+ */
+void RiseSet::calc_intp(double t, double* v) const {
+  const std::size_t nn = t_n.size();
+  std::size_t k;
+  double l0;
+  double l1;
+  double l2;
+  unsigned int j;
+
+  try {
+    k = static_cast<std::size_t>(std::max(0.0, (t - t_n[0]) / kStep));
+    if (k < 1) k = 1;
+    if (k > nn - 2) k = nn - 2;
+    const double  t0 = t_n[k - 1];
+    const double  t1 = t_n[k];
+    const double  t2 = t_n[k + 1];
+    const double* v0 = &v_n[(k - 1) * kNumNv];
+    const double* v1 = &v_n[k * kNumNv];
+    const double* v2 = &v_n[(k + 1) * kNumNv];
+    l0 = (t - t1) * (t - t2) / ((t0 - t1) * (t0 - t2));
+    l1 = (t - t0) * (t - t2) / ((t1 - t0) * (t1 - t2));
+    l2 = (t - t0) * (t - t1) / ((t2 - t0) * (t2 - t1));
+    for (j = 0; j < kNumNv; ++j) {
+      v[j] = l0 * v0[j] + l1 * v1[j] + l2 * v2[j];
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      計算: 高度 - 基準高度
+ *
+ * @param[in]  基準高度 (unsigned int; Evt / 2)
+ * @param[in]  観測地点番号 (size_t)
+ * @param[in]  節点の値・補間値 (const double*; kNumNv 個)
+ * @return     高度 - 基準高度（°） (double)
+ */
+double RiseSet::calc_e(unsigned int lvl, std::size_t i,
+                       const double* v) const {
+  const unsigned int o = (kLvlBody[lvl] == kGrpMon) ? kNvMonDec : kNvSunDec;
+  double dec;
+  double h0;
+  double sin_a;
+
+  dec   = v[o] * kD2R;
+  sin_a = sin_lat[i] * sin(dec)
+        + cos_lat[i] * cos(dec) * cos((v[o + 1] + lon[i]) * kD2R);
+  h0    = std::isnan(kLvlAlt[lvl]) ? -kRefr - v[o + 3] + v[o + 2]
+                                   : kLvlAlt[lvl];
+
+  return asin(sin_a) * kR2D - h0;
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,81 @@
+#ifndef EPHEMERIS_JCG_RISESET_HPP_
+#define EPHEMERIS_JCG_RISESET_HPP_
+
+#include "eph_jcg.hpp"
+#include "eph_year.hpp"
+#include "file.hpp"
+#include "result.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+// 現象（偶数: 上昇時の通過, 奇数: 下降時の通過）
+enum Evt : unsigned int {
+  kEvtSunRise = 0,  // 日の出
+  kEvtSunSet,       // 日の入
+  kEvtCivilBgn,     // 常用薄明（始）
+  kEvtCivilEnd,     // 常用薄明（終）
+  kEvtNautBgn,      // 航海薄明（始）
+  kEvtNautEnd,      // 航海薄明（終）
+  kEvtAstrBgn,      // 天文薄明（始）
+  kEvtAstrEnd,      // 天文薄明（終）
+  kEvtMonRise,      // 月の出
+  kEvtMonSet,       // 月の入
+  kNumEvt,          // 現象の数
+};
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 現象
+struct Event {
+  unsigned int loc;  // 観測地点番号
+  unsigned int evt;  // 現象（Evt）
+  double t;          // 時刻（UT1; 1970-01-01 00:00:00 からの秒）
+};
+
+// 地平線上にある期間
+struct Window {
+  unsigned int loc;   // 観測地点番号
+  unsigned int body;  // 天体（kGrpSun | kGrpMon）
+  double bgn;         // 開始（UT1; 1970-01-01 00:00:00 からの秒）
+  double end;         // 終了（UT1; 1970-01-01 00:00:00 からの秒）
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 出没・薄明（多数の観測地点・期間）
+// * 太陽・月の位置は 1 時間毎の節点でのみ計算し、全観測地点で共用する。
+// * 観測地点毎に節点間の符号変化で現象を挟み込み、節点の値の2次補間を用いて
+//   時刻を求める。（1時間以内に2回起こる現象（かすめる出没）は検出しない）
+class RiseSet {
+  std::vector<double> sin_lat;  // sin(緯度)
+  std::vector<double> cos_lat;  // cos(緯度)
+  std::vector<double> lon;      // 経度（°; 東経を正）
+  std::vector<double> t_n;      // 節点の時刻（UT1; 秒）
+  std::vector<double> v_n;      // 節点の値（節点毎に kNumNv 個）
+  EphYear eph;                  // 年毎の計算
+
+public:
+  RiseSet(const double*, const double*, std::size_t);  // コンストラクタ
+  std::size_t size() const;                            // 観測地点数
+  void calc(struct timespec, unsigned int,
+            std::vector<Event>&, std::vector<Window>&);  // 計算: 現象・期間
+
+private:
+  void calc_node(struct timespec, unsigned int);       // 計算: 節点
+  void calc_intp(double, double*) const;               // 計算: 補間
+  double calc_e(unsigned int, std::size_t, const double*) const;  // 計算: 高度 - 基準高度
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
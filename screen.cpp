@@ -0,0 +1,396 @@
+#include "screen.hpp"
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr double kPi      = atan(1.0) * 4;  // PI
+static constexpr double kD2R     = kPi / 180.0;    // 度 -> ラジアン
+static constexpr double kR2D     = 180.0 / kPi;    // ラジアン -> 度
+static constexpr double kSecDay  = 86400.0;        // Seconds in a day
+static constexpr double kS0Sun   = 16.02;          // SD 計算用係数: （太陽; ′）
+static constexpr double kS0Mon   = 0.2725;         // SD 計算用係数: （月）
+static constexpr double kHp0     = 8.794143;       // 1 AU での地平視差 (″)
+static constexpr double kPenum   = 1.02;           // 半影の半径の拡大率（大気の影響）
+static constexpr double kSdPlnMax = 1.0 / 60.0;    // 惑星の視半径の上限（°）
+static constexpr double kGold    = 0.6180339887498949;  // 黄金比 - 1
+static constexpr double kTolDay  = 1.0 / kSecDay;       // 時刻の精度（日）
+
+/*
+ * @brief      計算: 値（1適用期間の Chebyshev 級数; Clenshaw 法）
+ *
+ * @param[in]  係数 (Seg)
+ * @param[in]  係数の数 (unsigned int)
+ * @param[in]  値 (unsigned int; Qty)
+ * @param[in]  時刻引数 (double)
+ * @return     値 (double)
+ */
+static double eval_seg(const Seg& seg, unsigned int n, unsigned int q, double tm) {
+  double x;
+  double b0 = 0.0;
+  double b1 = 0.0;
+  double b2;
+  unsigned int i;
+
+  x = (2.0 * tm - (seg.a + seg.b)) / (static_cast<double>(seg.b) - seg.a);
+  if (x >  1.0) x =  1.0;
+  if (x < -1.0) x = -1.0;
+  for (i = n; i-- > 1;) {
+    b2 = b1;
+    b1 = b0;
+    b0 = 2.0 * x * b1 - b2 + seg.c[i][q];
+  }
+
+  return seg.c[0][q] + x * b0 - b1;
+}
+
+/*
+ * @brief      計算: 値の範囲の半幅（Σ|c_i|, i >= 1）
+ *
+ * @param[in]  係数 (Seg)
+ * @param[in]  係数の数 (unsigned int)
+ * @param[in]  値 (unsigned int; Qty)
+ * @return     半幅 (double)
+ */
+static double calc_span(const Seg& seg, unsigned int n, unsigned int q) {
+  double s = 0.0;
+  unsigned int i;
+
+  for (i = 1; i < n; ++i) s += std::abs(seg.c[i][q]);
+
+  return s;
+}
+
+/*
+ * @brief      計算: 角速度の上限（°/日）
+ *             * |T_i'(x)| <= i^2, dx/dt = 2 / (b - a) より、
+ *               15 |dα/dt| + |dδ/dt| の上限を求める。（cos δ <= 1）
+ *
+ * @param[in]  係数 (Seg)
+ * @param[in]  係数の数 (unsigned int)
+ * @return     角速度の上限 (double)
+ */
+static double calc_rate(const Seg& seg, unsigned int n) {
+  double s = 0.0;
+  unsigned int i;
+
+  for (i = 1; i < n; ++i) {
+    s += static_cast<double>(i) * i
+       * (15.0 * std::abs(seg.c[i][kQtyRa]) + std::abs(seg.c[i][kQtyDec]));
+  }
+
+  return s * 2.0 / (static_cast<double>(seg.b) - seg.a);
+}
+
+/*
+ * @brief      計算: 赤緯の変化率の上限（°/日）
+ *             * |T_i'(x)| <= i^2, dx/dt = 2 / (b - a) より、 |dδ/dt| の上限を求める。
+ *
+ * @param[in]  係数 (Seg)
+ * @param[in]  係数の数 (unsigned int)
+ * @return     赤緯の変化率の上限 (double)
+ */
+static double calc_rate_dec(const Seg& seg, unsigned int n) {
+  double s = 0.0;
+  unsigned int i;
+
+  for (i = 1; i < n; ++i) s += static_cast<double>(i) * i * std::abs(seg.c[i][kQtyDec]);
+
+  return s * 2.0 / (static_cast<double>(seg.b) - seg.a);
+}
+
+/*
+ * @brief      取得: 適用期間（EphJcg::calc_seg と同じ選択）
+ *             * 適用期間が無い場合は、先頭（未使用）を返す。（EphJcg と同じ）
+ *
+ * @param[in]  係数（区分単位） (GrpParam)
+ * @param[in]  時刻引数 (double)
+ * @return     適用期間 (const Seg&)
+ */
+static const Seg& find_seg(const GrpParam& gp, double tm) {
+  unsigned int i;
+
+  if (gp.n_seg == 0) return gp.seg[0];
+  for (i = 0; i < gp.n_seg; ++i) {
+    if (gp.seg[i].a <= tm && tm < gp.seg[i].b) return gp.seg[i];
+  }
+
+  return gp.seg[gp.n_seg - 1];
+}
+
+/*
+ * @brief      取得: 相手の区分
+ *
+ * @param[in]  種類 (unsigned int; Ecl)
+ * @return     区分 (unsigned int; Grp)
+ */
+static unsigned int get_grp(unsigned int k) {
+  return (k <= kEclLunar) ? static_cast<unsigned int>(kGrpSun)
+                          : k - kEclOccVns + kGrpVns;
+}
+
+/*
+ * @brief      計算: 角距離（°）
+ *             * 月の食（kEclLunar）は反太陽点との角距離。
+ *
+ * @param[in]  係数 (Param)
+ * @param[in]  種類 (unsigned int; Ecl)
+ * @param[in]  時刻引数 (double)
+ * @return     角距離 (double)
+ */
+static double calc_sep(const Param& prm, unsigned int k, double tm) {
+  const GrpParam& gm = prm.grp[kGrpMon];
+  const GrpParam& go = prm.grp[get_grp(k)];
+  const Seg& sm = find_seg(gm, tm);
+  const Seg& so = find_seg(go, tm);
+  double ra_m  = eval_seg(sm, gm.n_coef, kQtyRa,  tm) * 15.0 * kD2R;
+  double dec_m = eval_seg(sm, gm.n_coef, kQtyDec, tm) * kD2R;
+  double ra_o  = eval_seg(so, go.n_coef, kQtyRa,  tm) * 15.0 * kD2R;
+  double dec_o = eval_seg(so, go.n_coef, kQtyDec, tm) * kD2R;
+  double h_d;
+  double h_a;
+
+  if (k == kEclLunar) {
+    ra_o += kPi;
+    dec_o = -dec_o;
+  }
+  h_d = sin((dec_m - dec_o) / 2.0);
+  h_a = sin((ra_m - ra_o) / 2.0);
+
+  return 2.0 * asin(std::min(1.0, sqrt(h_d * h_d + cos(dec_m) * cos(dec_o) * h_a * h_a))) * kR2D;
+}
+
+/*
+ * @brief      計算: 赤緯差（°）
+ *             * 月の食（kEclLunar）は反太陽点との赤緯差。
+ *             * 角距離の下限となる。
+ *
+ * @param[in]  係数 (Param)
+ * @param[in]  種類 (unsigned int; Ecl)
+ * @param[in]  時刻引数 (double)
+ * @return     赤緯差 (double)
+ */
+static double calc_dec_dif(const Param& prm, unsigned int k, double tm) {
+  const GrpParam& gm = prm.grp[kGrpMon];
+  const GrpParam& go = prm.grp[get_grp(k)];
+  double dec_m = eval_seg(find_seg(gm, tm), gm.n_coef, kQtyDec, tm);
+  double dec_o = eval_seg(find_seg(go, tm), go.n_coef, kQtyDec, tm);
+
+  return std::abs((k == kEclLunar) ? dec_m + dec_o : dec_m - dec_o);
+}
+
+/*
+ * @brief      計算: 限界（°）
+ *             * 日食  : π(月) - π(日) + s(日) + s(月)
+ *             * 月食  : 1.02 (π(月) + π(日) + s(日)) + s(月)
+ *             * 星食  : π(月) + s(月) + s(惑星の上限)
+ *
+ *             * 太陽の距離は範囲で指定し、限界が大きくなる側を項毎に用いる。
+ *               （s(日) と月食の π(日) は下限、日食の -π(日) は上限; 時刻指定では同じ値）
+ *
+ * @param[in]  種類 (unsigned int; Ecl)
+ * @param[in]  月の地平視差 H.P.（°） (double)
+ * @param[in]  太陽の距離の下限（AU） (double)
+ * @param[in]  太陽の距離の上限（AU） (double)
+ * @return     限界 (double)
+ */
+static double calc_lim(unsigned int k, double hp, double d_min, double d_max) {
+  double sd_m = asin(kS0Mon * sin(hp * kD2R)) * kR2D;
+  double sd_s = kS0Sun / d_min / 60.0;
+
+  if (k == kEclSolar) return hp - kHp0 / d_max / 3600.0 + sd_s + sd_m;
+  if (k == kEclLunar) return kPenum * (hp + kHp0 / d_min / 3600.0 + sd_s) + sd_m;
+
+  return hp + sd_m + kSdPlnMax;
+}
+
+/*
+ * @brief      計算: 限界（°; 時刻指定）
+ *
+ * @param[in]  係数 (Param)
+ * @param[in]  種類 (unsigned int; Ecl)
+ * @param[in]  時刻引数 (double)
+ * @return     限界 (double)
+ */
+static double calc_lim_tm(const Param& prm, unsigned int k, double tm) {
+  const GrpParam& gm = prm.grp[kGrpMon];
+  const GrpParam& gs = prm.grp[kGrpSun];
+  double dist = eval_seg(find_seg(gs, tm), gs.n_coef, kQtyDist, tm);
+
+  return calc_lim(k, eval_seg(find_seg(gm, tm), gm.n_coef, kQtyHp, tm), dist, dist);
+}
+
+/*
+ * @brief      変換: 時刻引数 -> UT1
+ *
+ * @param[in]  係数 (Param)
+ * @param[in]  時刻引数 (double)
+ * @return     UT1 (timespec)
+ */
+static struct timespec tm2ts(const Param& prm, double tm) {
+  DateTime dt = {};
+  struct timespec ts;
+  double s;
+
+  dt.year  = prm.year;
+  dt.month = 1;
+  dt.day   = 1;
+  ts = dt2ts(dt);
+  s  = (tm - 1.0) * kSecDay - prm.dlt_t;
+  ts.tv_sec += static_cast<std::time_t>(std::floor(s));
+  ts.tv_nsec = static_cast<long>((s - std::floor(s)) * 1.0e9);
+
+  return ts;
+}
+
+/*
+ * @brief  コンストラクタ
+ */
+Screen::Screen() : stat() {}
+
+/*
+ * @brief       計算: 1年分
+ *              * 候補は種類毎に時刻順で追加する。
+ *              * 係数は前後の年と重なるので、最接近（UT1）が対象年のもののみ
+ *                追加する。（複数年を続けて計算しても重複しない）
+ *
+ * @param[in]   係数 (Param)
+ * @param[ref]  候補 (vector<EclCand>)
+ * @return      <none>
+ */
+void Screen::calc(const Param& prm, std::vector<EclCand>& cand) {
+  const GrpParam& gm = prm.grp[kGrpMon];
+  const GrpParam& gs = prm.grp[kGrpSun];
+  std::vector<std::pair<double, double>> leaf;  // 精査する部分区間
+  std::vector<std::pair<double, double>> stk;   // 分割待ちの部分区間
+  unsigned int k;
+  unsigned int i;
+  unsigned int j;
+
+  try {
+    if (gm.n_seg == 0 || gs.n_seg == 0) return;
+
+    // 対象年（UT1）の時刻引数の範囲
+    double tm_0 = 1.0 + prm.dlt_t / kSecDay;
+    double tm_1 = tm_0 + (days_from_civil(prm.year + 1, 1, 1)
+                        - days_from_civil(prm.year, 1, 1));
+
+    for (k = 0; k < kNumEcl; ++k) {
+      const GrpParam& go = prm.grp[get_grp(k)];
+      if (go.n_seg == 0) continue;
+      leaf.clear();
+      for (i = 0; i < gm.n_seg; ++i) {
+        const Seg& sm = gm.seg[i];
+        for (j = 0; j < go.n_seg; ++j) {
+          const Seg& so = go.seg[j];
+          double t0 = std::max<double>(sm.a, so.a);
+          double t1 = std::min<double>(sm.b, so.b);
+          if (t0 >= t1) continue;
+          ++stat.n_piece;
+
+          // 限界の上限（月の H.P. の上限, 太陽の距離の下限・上限）
+          const Seg& ss = find_seg(gs, (t0 + t1) / 2.0);
+          double hp_max = sm.c[0][kQtyHp] + calc_span(sm, gm.n_coef, kQtyHp);
+          double d_min  = ss.c[0][kQtyDist] - calc_span(ss, gs.n_coef, kQtyDist);
+          double d_max  = ss.c[0][kQtyDist] + calc_span(ss, gs.n_coef, kQtyDist);
+          double lim    = calc_lim(k, hp_max, std::max(d_min, 0.9), d_max);
+
+          // 二分（左から順に処理し、部分区間を時刻順に得る）
+          // * 中点の赤緯差・角距離から、変化率で部分区間内の下限を見積もって除外する。
+          double rate   = calc_rate(sm, gm.n_coef) + calc_rate(so, go.n_coef);
+          double rate_d = calc_rate_dec(sm, gm.n_coef) + calc_rate_dec(so, go.n_coef);
+          stk.assign(1, std::make_pair(t0, t1));
+          while (!stk.empty()) {
+            std::pair<double, double> iv = stk.back();
+            double w = iv.second - iv.first;
+            stk.pop_back();
+            ++stat.n_node;
+            if (calc_dec_dif(prm, k, iv.first + w / 2.0) - rate_d * w / 2.0 > lim) {
+              ++stat.n_prune;
+              continue;
+            }
+            if (calc_sep(prm, k, iv.first + w / 2.0) - rate * w / 2.0 > lim) continue;
+            if (w <= kScrLeaf) {
+              ++stat.n_leaf;
+              if (!leaf.empty() && leaf.back().second >= iv.first) {
+                leaf.back().second = iv.second;
+              } else {
+                leaf.push_back(iv);
+              }
+              continue;
+            }
+            stk.emplace_back(iv.first + w / 2.0, iv.second);
+            stk.emplace_back(iv.first, iv.first + w / 2.0);
+          }
+        }
+      }
+
+      // 精査（最接近: 黄金分割探索, 開始・終了: 二分法）
+      for (auto& iv : leaf) {
+        double a = iv.first;
+        double b = iv.second;
+        double x1 = b - kGold * (b - a);
+        double x2 = a + kGold * (b - a);
+        double f1 = calc_sep(prm, k, x1);
+        double f2 = calc_sep(prm, k, x2);
+        while (b - a > kTolDay) {
+          if (f1 < f2) {
+            b = x2; x2 = x1; f2 = f1;
+            x1 = b - kGold * (b - a);
+            f1 = calc_sep(prm, k, x1);
+          } else {
+            a = x1; x1 = x2; f1 = f2;
+            x2 = a + kGold * (b - a);
+            f2 = calc_sep(prm, k, x2);
+          }
+        }
+        double t_max = (a + b) / 2.0;
+        if (t_max < tm_0 || t_max >= tm_1) continue;
+        double s_min = calc_sep(prm, k, t_max);
+        double l_max = calc_lim_tm(prm, k, t_max);
+        if (s_min >= l_max) continue;
+
+        EclCand c;
+        double lo;
+        double hi;
+        double md;
+        c.kind = k;
+        c.sep  = s_min;
+        c.lim  = l_max;
+        c.max  = tm2ts(prm, t_max);
+        for (lo = iv.first, hi = t_max; hi - lo > kTolDay;) {
+          md = (lo + hi) / 2.0;
+          if (calc_sep(prm, k, md) < calc_lim_tm(prm, k, md)) hi = md; else lo = md;
+        }
+        c.bgn = tm2ts(prm, hi);
+        for (lo = t_max, hi = iv.second; hi - lo > kTolDay;) {
+          md = (lo + hi) / 2.0;
+          if (calc_sep(prm, k, md) < calc_lim_tm(prm, k, md)) lo = md; else hi = md;
+        }
+        c.end = tm2ts(prm, lo);
+        cand.push_back(c);
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      取得: 統計
+ *             * calc の呼び出し毎に累積する。
+ *
+ * @param[in]  <none>
+ * @return     統計 (const ScrStat&)
+ */
+const ScrStat& Screen::get_stat() const {
+  return stat;
+}
+
+}  // namespace ephemeris_jcg
+
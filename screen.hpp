@@ -0,0 +1,76 @@
+#ifndef EPHEMERIS_JCG_SCREEN_HPP_
+#define EPHEMERIS_JCG_SCREEN_HPP_
+
+#include "file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+// 現象の種類
+enum Ecl : unsigned int {
+  kEclSolar = 0,  // 日食
+  kEclLunar,      // 月食（半影食を含む）
+  kEclOccVns,     // 金星食
+  kEclOccMrs,     // 火星食
+  kEclOccJpt,     // 木星食
+  kEclOccSat,     // 土星食
+  kNumEcl,        // 種類の数
+};
+
+static constexpr double kScrLeaf = 1.0 / 24.0;  // 分割の最小幅（日）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 食・星食の候補
+// * 角距離は地心での月と相手（太陽・反太陽点・惑星）の中心間。
+struct EclCand {
+  unsigned int kind;      // 種類（Ecl）
+  struct timespec bgn;    // 開始（UT1; 角距離 = 限界）
+  struct timespec max;    // 最接近（UT1）
+  struct timespec end;    // 終了（UT1; 角距離 = 限界）
+  double sep;             // 最接近時の角距離（°）
+  double lim;             // 最接近時の限界（°）
+};
+
+// 絞り込みの統計
+struct ScrStat {
+  std::uint64_t n_piece;  // 区間数（両天体の適用期間の共通部分）
+  std::uint64_t n_prune;  // 赤緯差だけで除外した部分区間数
+  std::uint64_t n_node;   // 分割で調べた部分区間数
+  std::uint64_t n_leaf;   // 除外できず精査した最小幅の部分区間数
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 食・星食の候補の検索
+// * 月と相手の適用期間の共通部分毎に、係数の大きさから
+//     値の範囲: |f - c0| <= Σ|c_i|（i >= 1）
+//     変化率  : |f'| <= 2 / (b - a) Σ i^2 |c_i|
+//   を求める。（値の範囲は限界の上限に使う）
+//   - 区間を二分し、中点の赤緯差から赤緯の変化率で部分区間内の下限を見積もり、
+//     限界以上離れていれば除外する。（赤緯差 <= 角距離）
+//   - それ以外は、中点の角距離から角速度で下限を見積もって除外する。
+//   - 最小幅まで残った部分区間を連結し、最接近・開始・終了を求める。
+// * 係数は前後の年と重なるので、最接近（UT1）が対象年の候補のみを返す。
+class Screen {
+  ScrStat stat;  // 統計
+
+public:
+  Screen();                                           // コンストラクタ
+  void calc(const Param&, std::vector<EclCand>&);     // 計算: 1年分
+  const ScrStat& get_stat() const;                    // 取得: 統計
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,136 @@
+#include "shm.hpp"
+
+#include "common.hpp"
+#include "eph_jcg.hpp"
+
+#include <chrono>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ephemeris_jcg {
+
+/*
+ * @brief  コンストラクタ（公開側）
+ *         * 共有メモリを作成（既存なら再利用）してマップする。
+ *
+ * @param[in]  共有メモリ名 (string)
+ */
+ShmPub::ShmPub(const std::string& name) : name(name), seg(nullptr) {
+  int fd;
+  void* m;
+  std::uint64_t s;
+
+  try {
+    fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, sizeof(ShmSeg)) != 0) {
+      std::cout << "[ERROR] Could not open \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    m = mmap(nullptr, sizeof(ShmSeg), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+      std::cout << "[ERROR] Could not map \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    seg = static_cast<ShmSeg*>(m);
+    if (std::memcmp(seg->magic, kShmMagic, sizeof(kShmMagic)) != 0) {
+      seg = new (m) ShmSeg;
+      seg->seq.store(0);
+      for (auto& w : seg->w) w.store(0);
+      std::memcpy(seg->magic, kShmMagic, sizeof(kShmMagic));
+    }
+    // 前回の公開側が書き込み中に終了していた場合
+    s = seg->seq.load();
+    if (s & 1) seg->seq.store(s + 1);
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  デストラクタ（公開側）
+ *         * 共有メモリは削除しない。（購読側は最後の値を読み続けられる）
+ */
+ShmPub::~ShmPub() {
+  if (seg != nullptr) munmap(seg, sizeof(ShmSeg));
+}
+
+/*
+ * @brief      公開: 1件
+ *             * seqlock: 版数を奇数にしてから値を書き込み、偶数に戻す。
+ *
+ * @param[in]  UT1 (timespec)
+ * @param[in]  計算結果 (Result)
+ * @return     <none>
+ */
+void ShmPub::publish(struct timespec ut1, const Result& res) {
+  std::uint64_t v[kShmNumWord];  // 値
+  std::uint64_t s;               // 版数
+  unsigned int i;                // loop index
+
+  v[0] = static_cast<std::uint64_t>(ut1.tv_sec);
+  v[1] = static_cast<std::uint64_t>(ut1.tv_nsec);
+  std::memcpy(v + 2, &res, sizeof(Result));
+  s = seg->seq.load(std::memory_order_relaxed);
+  seg->seq.store(s + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (i = 0; i < kShmNumWord; ++i) {
+    seg->w[i].store(v[i], std::memory_order_relaxed);
+  }
+  seg->seq.store(s + 2, std::memory_order_release);
+}
+
+/*
+ * @brief      公開: 現在時刻
+ *             * 指定の周波数で現在時刻（システム日時）を計算し、公開する。
+ *             * 係数は Store から取得する。（再読み込みに追従）
+ *             * 対象年の係数が無い場合は公開せず、警告を1回だけ出力する。
+ *
+ * @param[in]  係数・ΔT の保持 (Store&)
+ * @param[in]  周波数（Hz） (double)
+ * @param[in]  回数（0: 無限） (uint64_t)
+ * @return     <none>
+ */
+void ShmPub::run(Store& st, double hz, std::uint64_t n) {
+  std::chrono::steady_clock::time_point next;  // 次回の時刻
+  std::chrono::nanoseconds period(static_cast<long long>(1.0e9 / hz));  // 間隔
+  struct timespec ut1;                         // UT1
+  Result res;                                  // 計算結果
+  unsigned int warned = 0;                     // 警告済みの年
+  unsigned int year;                           // 西暦年
+  std::uint64_t k;                             // loop index
+
+  try {
+    next = std::chrono::steady_clock::now();
+    for (k = 0; n == 0 || k < n; ++k) {
+      std::timespec_get(&ut1, TIME_UTC);
+      year = ts2dt(ut1).year;
+      {
+        Store::Reader rd(st);
+        const Param* p = rd.find(year);
+        if (p != nullptr) {
+          EphJcg o_e(*p);
+          o_e.calc(ut1, res);
+          publish(ut1, res);
+        } else if (warned != year) {
+          std::cout << "[WARNING] " << year << " is not loaded!" << std::endl;
+          warned = year;
+        }
+      }
+      next += period;
+      std::this_thread::sleep_until(next);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+}  // namespace ephemeris_jcg
+
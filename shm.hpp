@@ -0,0 +1,36 @@
+#ifndef EPHEMERIS_JCG_SHM_HPP_
+#define EPHEMERIS_JCG_SHM_HPP_
+
+#include "result.hpp"
+#include "shm_sub.hpp"
+#include "store.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 共有メモリ: 公開側
+// * 現在時刻の計算結果を一定間隔で共有メモリに書き込む。（1回の計算を全購読側で共用）
+// * 配置（ShmSeg）・購読側（ShmSub）は shm_sub.hpp。
+class ShmPub {
+  std::string name;  // 共有メモリ名（"/..."）
+  ShmSeg* seg;       // マップ先頭
+
+public:
+  ShmPub(const std::string&);                     // コンストラクタ
+  ~ShmPub();                                      // デストラクタ
+  ShmPub(const ShmPub&) = delete;
+  ShmPub& operator=(const ShmPub&) = delete;
+  void publish(struct timespec, const Result&);   // 公開: 1件
+  void run(Store&, double, std::uint64_t = 0);    // 公開: 現在時刻（周波数, 回数（0: 無限））
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
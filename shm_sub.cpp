@@ -0,0 +1,111 @@
+#include "shm_sub.hpp"
+
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ephemeris_jcg {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "64-bit atomics must be lock-free to live in shared memory");
+static_assert(sizeof(Result) % sizeof(std::uint64_t) == 0,
+              "Result must be a whole number of 64-bit words");
+
+/*
+ * @brief  コンストラクタ（購読側）
+ *         * 公開側が作成した共有メモリを読み取り専用でマップする。
+ *         * 大きさ・識別子を確認してから返す。（短い共有メモリをマップすると、
+ *           読み取り時に SIGBUS となるため）
+ *
+ * @param[in]  共有メモリ名 (string)
+ */
+ShmSub::ShmSub(const std::string& name) : seg(nullptr) {
+  int fd;
+  void* m;
+  struct stat st;
+
+  try {
+    fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      std::cout << "[ERROR] Could not open \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(ShmSeg))) {
+      close(fd);
+      std::cout << "[ERROR] Invalid segment \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    m = mmap(nullptr, sizeof(ShmSeg), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+      std::cout << "[ERROR] Could not map \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    seg = static_cast<const ShmSeg*>(m);
+    if (std::memcmp(seg->magic, kShmMagic, sizeof(kShmMagic)) != 0) {
+      munmap(m, sizeof(ShmSeg));
+      seg = nullptr;
+      std::cout << "[ERROR] Invalid segment \"" << name << "\"!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  デストラクタ（購読側）
+ */
+ShmSub::~ShmSub() {
+  if (seg != nullptr) munmap(const_cast<ShmSeg*>(seg), sizeof(ShmSeg));
+}
+
+/*
+ * @brief       取得: 最新の計算結果
+ *              * seqlock: 読み取り前後で版数が一致し、偶数であれば有効。
+ *                （一致しなければ読み直す）
+ *
+ * @param[ref]  UT1 (timespec)
+ * @param[ref]  計算結果 (Result)
+ * @return      true（取得）| false（未公開）
+ */
+bool ShmSub::read(struct timespec& ut1, Result& res) const {
+  std::uint64_t v[kShmNumWord];  // 値
+  std::uint64_t s0;              // 版数（読み取り前）
+  std::uint64_t s1;              // 版数（読み取り後）
+  unsigned int i;                // loop index
+
+  do {
+    s0 = seg->seq.load(std::memory_order_acquire);
+    if (s0 == 0) return false;
+    if (s0 & 1) continue;
+    for (i = 0; i < kShmNumWord; ++i) {
+      v[i] = seg->w[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    s1 = seg->seq.load(std::memory_order_relaxed);
+  } while ((s0 & 1) || s0 != s1);
+  ut1.tv_sec  = static_cast<std::time_t>(v[0]);
+  ut1.tv_nsec = static_cast<long>(v[1]);
+  std::memcpy(&res, v + 2, sizeof(Result));
+
+  return true;
+}
+
+/*
+ * @brief      取得: 版数
+ *             * 公開毎に 2 ずつ増える。（更新の有無の確認用）
+ *
+ * @param[in]  <none>
+ * @return     版数 (uint64_t)
+ */
+std::uint64_t ShmSub::get_seq() const {
+  return seg->seq.load(std::memory_order_acquire);
+}
+
+}  // namespace ephemeris_jcg
@@ -0,0 +1,53 @@
+#ifndef EPHEMERIS_JCG_SHM_SUB_HPP_
+#define EPHEMERIS_JCG_SHM_SUB_HPP_
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr char         kShmMagic[8] = {'E', 'P', 'H', 'J', 'C', 'G', 'S', '1'};
+static constexpr unsigned int kShmNumWord  = 2 + sizeof(Result) / sizeof(std::uint64_t);  // 語数（時刻 + 計算結果）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 共有メモリ: 配置
+// * seq は seqlock の版数。（奇数: 書き込み中, 0: 未公開）
+// * w は UT1（秒, ナノ秒）と計算結果（Result）を 64 bit 語単位で格納する。
+struct ShmSeg {
+  char magic[8];                                        // 識別子
+  alignas(64) std::atomic<std::uint64_t> seq;           // 版数
+  alignas(64) std::atomic<std::uint64_t> w[kShmNumWord];  // 値
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 共有メモリ: 購読側
+// * 読み取りはロック無し。（書き込みと重なった場合は読み直す）
+// * 公開側（ShmPub; shm.hpp）とは独立しており、 shm_sub.o のみでリンクできる。
+class ShmSub {
+  const ShmSeg* seg;  // マップ先頭
+
+public:
+  ShmSub(const std::string&);                     // コンストラクタ
+  ~ShmSub();                                      // デストラクタ
+  ShmSub(const ShmSub&) = delete;
+  ShmSub& operator=(const ShmSub&) = delete;
+  bool read(struct timespec&, Result&) const;     // 取得: 最新の計算結果
+  std::uint64_t get_seq() const;                  // 取得: 版数
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,148 @@
+#include "star.hpp"
+
+#include <algorithm>
+#include <cstdlib>   // for EXIT_XXXX
+#include <iostream>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr std::size_t kBlk = 64;  // 一括計算する恒星数・時刻数
+
+/*
+ * @brief  コンストラクタ
+ *
+ * @param[in]  恒星の係数 (StarCat)
+ */
+Star::Star(const StarCat& cat) : cat(cat) {}
+
+/*
+ * @brief   恒星数
+ *
+ * @param   <none>
+ * @return  恒星数 (size_t)
+ */
+std::size_t Star::size() const {
+  return cat.no.size();
+}
+
+/*
+ * @brief   取得: 恒星の係数
+ *
+ * @param   <none>
+ * @return  恒星の係数 (StarCat)
+ */
+const StarCat& Star::get_cat() const {
+  return cat;
+}
+
+/*
+ * @brief       計算: 1時刻
+ *              * EphJcg で計算済みの時刻の R.A., Dec., グリニッジ時角を全恒星分計算する。
+ *              * cos(Nθ) は θ = cos^(-1)(x) の Chebyshev 多項式 T_N(x) の漸化式
+ *                  T_N(x) = 2x * T_(N-1)(x) - T_(N-2)(x)
+ *                で求め、恒星方向に連続したループで計算する。（acos, cos を使用しない）
+ *              * 恒星の係数と EphJcg の係数の年が異なる場合はエラー終了する。
+ *
+ * @param[in]   計算（calc 済み） (EphJcg)
+ * @param[in]   計算結果（同じ時刻で calc したもの; R を使用） (Result)
+ * @param[out]  R.A. 配列（h） (double*; 恒星数分)
+ * @param[out]  Dec. 配列（°） (double*; 恒星数分)
+ * @param[out]  グリニッジ時角配列（h） (double*; 恒星数分)
+ * @return      <none>
+ */
+void Star::calc(const EphJcg& e, const Result& res,
+                double* ra, double* dec, double* gha) const {
+  const std::size_t n  = size();
+  const double      tm = e.get_tm();
+  const double      hg = res.r + e.get_f() * 24.0;
+  double x[kBlk];   // 時刻引数（-1 - 1）
+  double t0[kBlk];  // T_(N-2)
+  double t1[kBlk];  // T_(N-1)
+  std::size_t j0;
+  std::size_t m;
+  std::size_t j;
+  unsigned int i;
+
+  try {
+    if (cat.year != e.get_year()) {
+      std::cout << "[ERROR] " << cat.year << " is not "
+                << e.get_year() << "!" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    for (j0 = 0; j0 < n; j0 += kBlk) {
+      m = std::min(kBlk, n - j0);
+      const double* a = &cat.a[j0];
+      const double* b = &cat.b[j0];
+      for (j = 0; j < m; ++j) {
+        x[j] = (2.0 * tm - (a[j] + std::max(b[j], tm))) / (std::max(b[j], tm) - a[j]);
+        x[j] = std::min(1.0, std::max(-1.0, x[j]));
+        t0[j] = 1.0;
+        t1[j] = x[j];
+        ra[j0 + j]  = cat.c_ra [j0 + j];
+        dec[j0 + j] = cat.c_dec[j0 + j];
+      }
+      for (i = 1; i < cat.n_coef; ++i) {
+        const double* c_r = &cat.c_ra [i * n + j0];
+        const double* c_d = &cat.c_dec[i * n + j0];
+        for (j = 0; j < m; ++j) {
+          double t = (i == 1) ? t1[j] : 2.0 * x[j] * t1[j] - t0[j];
+          ra[j0 + j]  += c_r[j] * t;
+          dec[j0 + j] += c_d[j] * t;
+          if (i > 1) {
+            t0[j] = t1[j];
+            t1[j] = t;
+          }
+        }
+      }
+      for (j = 0; j < m; ++j) {
+        while (ra[j0 + j] >= 24.0) ra[j0 + j] -= 24.0;
+        while (ra[j0 + j] <   0.0) ra[j0 + j] += 24.0;
+        gha[j0 + j] = hg - ra[j0 + j];
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算: 多数の時刻
+ *              * 出力配列は時刻毎に恒星数分ずつ連続する。（要素数: 時刻数 * 恒星数）
+ *              * 時刻は kBlk 件毎に ts2tf で一括変換してから計算する。
+ *
+ * @param[ref]  計算 (EphJcg; 各時刻で calc する)
+ * @param[in]   UT1 配列 (const timespec*)
+ * @param[in]   時刻数 (size_t)
+ * @param[out]  R.A. 配列（h） (double*)
+ * @param[out]  Dec. 配列（°） (double*)
+ * @param[out]  グリニッジ時角配列（h） (double*)
+ * @return      <none>
+ */
+void Star::calc(EphJcg& e, const struct timespec* ts, std::size_t n_ts,
+                double* ra, double* dec, double* gha) const {
+  const std::size_t n = size();
+  int          y[kBlk];  // 西暦年
+  unsigned int t[kBlk];  // 通日 T
+  double       f[kBlk];  // UT1 の日の端数 F
+  Result res;
+  std::size_t k0;
+  std::size_t m;
+  std::size_t k;
+
+  try {
+    for (k0 = 0; k0 < n_ts; k0 += kBlk) {
+      m = std::min(kBlk, n_ts - k0);
+      ts2tf(ts + k0, m, y, t, f);
+      for (k = k0; k < k0 + m; ++k) {
+        e.calc(y[k - k0], t[k - k0], f[k - k0], res);
+        calc(e, res, ra + k * n, dec + k * n, gha + k * n);
+      }
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+}  // namespace ephemeris_jcg
+
@@ -0,0 +1,31 @@
+#ifndef EPHEMERIS_JCG_STAR_HPP_
+#define EPHEMERIS_JCG_STAR_HPP_
+
+#include "eph_jcg.hpp"
+#include "file.hpp"
+#include "result.hpp"
+
+#include <cstddef>
+#include <ctime>
+
+namespace ephemeris_jcg {
+
+// 恒星の視位置（全恒星一括）
+// * 時刻引数は EphJcg（同年の係数）で計算したものを、R はその計算結果を使用する。
+class Star {
+  StarCat cat;  // 恒星の係数
+
+public:
+  Star(const StarCat&);                  // コンストラクタ
+  std::size_t size() const;              // 恒星数
+  const StarCat& get_cat() const;        // 取得: 恒星の係数
+  void calc(const EphJcg&, const Result&,
+            double*, double*, double*) const;                 // 計算: 1時刻
+  void calc(EphJcg&, const struct timespec*, std::size_t,
+            double*, double*, double*) const;                 // 計算: 多数の時刻
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,282 @@
+#include "store.hpp"
+
+#include <exception>
+#include <iostream>
+
+namespace ephemeris_jcg {
+
+/*
+ * @brief      取得: 対象年の係数
+ *
+ * @param[in]  西暦年 (unsigned int)
+ * @return     係数 (const Param*)
+ *             （対象年が読み込まれていない場合、 nullptr）
+ */
+const Param* Snapshot::find(unsigned int year) const {
+  for (auto& p : prm) {
+    if (p->year == year) return p.get();
+  }
+
+  return nullptr;
+}
+
+/*
+ * @brief      コンストラクタ（読み取り）
+ *             * 空きスロットに現在のエポックを記録してから、公開中の
+ *               スナップショットを取得する。（ロック無し）
+ *             * 空きスロットが無い場合は、空くまで待つ。
+ *
+ * @param[in]  保持元 (Store&)
+ */
+Store::Reader::Reader(Store& st) : st(st), i(0), snap(nullptr) {
+  static thread_local unsigned int i_hint = static_cast<unsigned int>(
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % kNumSlot);
+  std::uint64_t e;  // エポック
+  std::uint64_t z;  // 空きスロットの値
+  unsigned int k;   // loop index
+
+  for (k = 0; ; ++k) {
+    i = (i_hint + k) % kNumSlot;
+    e = st.epoch.load();
+    z = 0;
+    if (st.slot[i].compare_exchange_strong(z, e)) break;
+    if (k % kNumSlot == kNumSlot - 1) std::this_thread::yield();
+  }
+  i_hint = i;
+  snap = st.cur.load();
+}
+
+/*
+ * @brief  デストラクタ（読み取り）
+ *         * スロットを空ける。
+ */
+Store::Reader::~Reader() {
+  st.slot[i].store(0);
+}
+
+/*
+ * @brief      取得: スナップショット
+ *
+ * @param[in]  <none>
+ * @return     スナップショット (const Snapshot&)
+ */
+const Snapshot& Store::Reader::get() const {
+  return *snap;
+}
+
+/*
+ * @brief      取得: 対象年の係数
+ *
+ * @param[in]  西暦年 (unsigned int)
+ * @return     係数 (const Param*)
+ *             （対象年が読み込まれていない場合、 nullptr）
+ */
+const Param* Store::Reader::find(unsigned int year) const {
+  return snap->find(year);
+}
+
+/*
+ * @brief  コンストラクタ
+ *         * 係数ファイルの存在する全ての年を読み込む。
+ *
+ * @param[in]  許容誤差 (double; ″; 0 以下なら打ち切らない)
+ */
+Store::Store(double tol) : epoch(1), stop(false), tol(tol), n_fail(0) {
+  File o_f(true);
+
+  try {
+    for (auto& s : slot) s.store(0);
+    cur.store(load(1, o_f.get_stamp()));
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief  デストラクタ
+ *         * 監視を停止し、全てのスナップショットを解放する。
+ *           （Reader が残っていないこと）
+ */
+Store::~Store() {
+  unwatch();
+  for (auto& r : retired) delete r.first;
+  delete cur.load();
+}
+
+/*
+ * @brief      再読み込み
+ *             * ファイルの更新情報が読み込み時から変化している場合のみ、
+ *               全体を読み直して差し替える。
+ *             * 旧スナップショットは参照が無くなってから解放する。
+ *             * 読み込みに失敗した場合は警告を表示し、差し替えない。
+ *               （その更新情報のままなら、以降は読み込まない）
+ *
+ * @param[in]  <none>
+ * @return     差し替えの有無 (bool)
+ */
+bool Store::reload() {
+  File o_f(true);
+  std::string stamp;    // ファイルの更新情報
+  const Snapshot* old;  // 旧スナップショット
+  Snapshot* snap;       // 新スナップショット
+  std::uint64_t e;      // 差し替え後のエポック
+
+  try {
+    std::lock_guard<std::mutex> lk(mtx);
+    reclaim();
+    old = cur.load();
+    try {
+      stamp = o_f.get_stamp();
+      if (stamp == old->stamp || stamp == stamp_ng) return false;
+      snap = load(old->gen + 1, stamp);
+    } catch (const std::exception& e) {
+      ++n_fail;
+      stamp_ng = stamp;
+      std::cerr << "[WARNING] Reload failed: " << e.what()
+                << " (keeping generation " << old->gen << ")" << std::endl;
+      return false;
+    }
+    old = cur.exchange(snap);
+    e = epoch.fetch_add(1) + 1;
+    retired.emplace_back(old, e);
+    reclaim();
+  } catch (...) {
+    throw;
+  }
+
+  return true;
+}
+
+/*
+ * @brief      監視開始
+ *             * 指定間隔でファイルの更新を確認し、再読み込みする。
+ *
+ * @param[in]  間隔（ミリ秒） (unsigned int)
+ * @return     <none>
+ */
+void Store::watch(unsigned int ms) {
+  try {
+    if (th.joinable()) return;
+    stop = false;
+    th = std::thread([this, ms]() {
+      std::unique_lock<std::mutex> lk(mtx_th);
+      while (!cv.wait_for(lk, std::chrono::milliseconds(ms),
+                          [this]() { return stop; })) {
+        lk.unlock();
+        reload();
+        lk.lock();
+      }
+    });
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      監視停止
+ *
+ * @param[in]  <none>
+ * @return     <none>
+ */
+void Store::unwatch() {
+  try {
+    {
+      std::lock_guard<std::mutex> lk(mtx_th);
+      stop = true;
+    }
+    cv.notify_all();
+    if (th.joinable()) th.join();
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief      取得: 解放待ちの数
+ *             * 解放可能なものは解放してから数える。
+ *
+ * @param[in]  <none>
+ * @return     解放待ちの数 (size_t)
+ */
+std::size_t Store::get_n_retired() {
+  std::lock_guard<std::mutex> lk(mtx);
+
+  reclaim();
+  return retired.size();
+}
+
+/*
+ * @brief      取得: 再読み込みに失敗した回数
+ *
+ * @param[in]  <none>
+ * @return     失敗した回数 (uint64_t)
+ */
+std::uint64_t Store::get_n_fail() {
+  std::lock_guard<std::mutex> lk(mtx);
+
+  return n_fail;
+}
+
+/*
+ * @brief      読み込み
+ *             * ΔT の無い年は読み込まない。
+ *             * 許容誤差の指定があれば、読み込み後に係数を打ち切る。
+ *             * ファイルを開けない・内容が不正な場合は例外を送出する。
+ *               （File の例外モード）
+ *
+ * @param[in]  世代 (uint64_t)
+ * @param[in]  ファイルの更新情報 (string)
+ * @return     スナップショット (Snapshot*)
+ */
+Snapshot* Store::load(std::uint64_t gen, const std::string& stamp) {
+  File o_f(true);
+  std::unique_ptr<Snapshot> snap(new Snapshot);
+
+  try {
+    snap->gen   = gen;
+    snap->stamp = stamp;
+    snap->trc   = TruncStat();
+    for (auto year : o_f.get_years()) {
+      if (o_f.get_delta_t(year) == 0) continue;
+      snap->prm.emplace_back(new Param);
+      o_f.get_param(year, *snap->prm.back());
+      if (tol > 0.0) Trunc(tol).calc(*snap->prm.back(), snap->trc);
+    }
+  } catch (...) {
+    throw;
+  }
+
+  return snap.release();
+}
+
+/*
+ * @brief      解放
+ *             * 退避時のエポックより前のエポックを記録したスロットが無ければ、
+ *               その旧スナップショットを参照する Reader は存在しない。
+ *             * 更新側の排他（mtx）の中で呼ぶこと。
+ *
+ * @param[in]  <none>
+ * @return     <none>
+ */
+void Store::reclaim() {
+  std::uint64_t e_min = UINT64_MAX;  // 読み取り中の最小エポック
+  std::uint64_t e;                   // スロットの値
+  std::size_t i;                     // loop index
+  std::size_t j = 0;                 // 残す数
+
+  for (auto& s : slot) {
+    e = s.load();
+    if (e != 0 && e < e_min) e_min = e;
+  }
+  for (i = 0; i < retired.size(); ++i) {
+    if (retired[i].second <= e_min) {
+      delete retired[i].first;
+    } else {
+      retired[j++] = retired[i];
+    }
+  }
+  retired.resize(j);
+}
+
+}  // namespace ephemeris_jcg
+
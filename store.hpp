@@ -0,0 +1,102 @@
+#ifndef EPHEMERIS_JCG_STORE_HPP_
+#define EPHEMERIS_JCG_STORE_HPP_
+
+#include "file.hpp"
+#include "trunc.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr unsigned int kNumSlot = 128;  // 同時に読み取り可能な数（Reader）
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 読み込み済みデータ（不変; 差し替えの単位）
+struct Snapshot {
+  std::uint64_t gen;                        // 世代（1 から）
+  std::string stamp;                        // 読み込み時のファイルの更新情報
+  std::vector<std::unique_ptr<Param>> prm;  // 年毎の係数（西暦年昇順）
+  TruncStat trc;                            // 打ち切りの結果（全ての年）
+
+  const Param* find(unsigned int) const;    // 取得: 対象年の係数
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 係数・ΔT の保持（実行中の再読み込み）
+// * txt/ 内のファイルの追加・更新を検知すると全体を読み直し、アトミックに差し替える。
+// * 読み取り側はロックを取らない。（エポック方式）
+//   - Reader の生成時に現在のエポックを空きスロットへ記録し、その後に
+//     公開中のスナップショットを取得する。
+//   - 差し替え時は旧スナップショットを退避し、エポックを進める。
+//     退避時のエポックより前のスロットが無くなれば、参照が無いので解放する。
+// * 再読み込みに失敗した場合（書き込み途中・不正なファイル）は、警告を表示して
+//   公開中のスナップショットを使い続ける。（同じ更新情報では再試行しない）
+//   初回読み込みの失敗は、コンストラクタから std::runtime_error を送出する。
+class Store {
+  std::atomic<const Snapshot*> cur;               // 公開中のスナップショット
+  std::atomic<std::uint64_t> epoch;               // エポック（1 から）
+  std::atomic<std::uint64_t> slot[kNumSlot];      // 読み取り中のエポック（0: 空き）
+  std::mutex mtx;                                 // 更新側の排他
+  std::vector<std::pair<const Snapshot*, std::uint64_t>> retired;  // 解放待ち
+  std::thread th;                                 // 監視スレッド
+  std::mutex mtx_th;                              // 監視スレッド: 停止通知用
+  std::condition_variable cv;                     // 監視スレッド: 停止通知用
+  bool stop;                                      // 監視スレッド: 停止要求
+  double tol;                                     // 許容誤差（″; 0 なら打ち切らない）
+  std::string stamp_ng;                           // 読み込みに失敗した更新情報
+  std::uint64_t n_fail;                           // 読み込みに失敗した回数
+
+public:
+  // 読み取り（ロック無し）
+  // * 生存中は取得したスナップショットが解放されない。
+  class Reader {
+    Store& st;              // 保持元
+    unsigned int i;         // スロットの添字
+    const Snapshot* snap;   // スナップショット
+
+  public:
+    explicit Reader(Store&);                 // コンストラクタ
+    ~Reader();                               // デストラクタ
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    const Snapshot& get() const;             // 取得: スナップショット
+    const Param* find(unsigned int) const;   // 取得: 対象年の係数
+  };
+
+  explicit Store(double = 0.0);     // コンストラクタ（初回読み込み）
+  ~Store();                         // デストラクタ
+  Store(const Store&) = delete;
+  Store& operator=(const Store&) = delete;
+  bool reload();                    // 再読み込み（更新があった場合のみ）
+  void watch(unsigned int);         // 監視開始（間隔: ミリ秒）
+  void unwatch();                   // 監視停止
+  std::size_t get_n_retired();      // 取得: 解放待ちの数
+  std::uint64_t get_n_fail();       // 取得: 再読み込みに失敗した回数
+
+private:
+  Snapshot* load(std::uint64_t, const std::string&);  // 読み込み
+  void reclaim();                                      // 解放
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
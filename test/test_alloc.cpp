@@ -0,0 +1,108 @@
+/***********************************************************
+  テスト: 計算時のヒープ領域の確保
+
+  * 全域の operator new を置き換えて呼び出し回数を数え、
+    係数の読み込み後の EphJcg::calc（多数の時刻の一括計算を含む）で
+    ヒープ領域の確保が 0 回であることを確認する。
+  * 打ち切り（Trunc）後の係数についても同様に確認する。
+***********************************************************/
+#include "eph_jcg.hpp"
+#include "trunc.hpp"
+
+#include <atomic>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <new>
+
+namespace ns = ephemeris_jcg;
+
+static std::atomic<unsigned long> n_new(0);  // operator new の呼び出し回数
+
+void* operator new(std::size_t sz) {
+  ++n_new;
+  if (void* p = std::malloc(sz ? sz : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t sz) {
+  ++n_new;
+  if (void* p = std::malloc(sz ? sz : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t sz, const std::nothrow_t&) noexcept {
+  ++n_new;
+  return std::malloc(sz ? sz : 1);
+}
+
+void* operator new[](std::size_t sz, const std::nothrow_t&) noexcept {
+  ++n_new;
+  return std::malloc(sz ? sz : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+/*
+ * @brief       計算（1年分を一定間隔で）し、ヒープ領域の確保回数を返す
+ *              * calc(ts, res), calc(ts), calc(ts 配列, 件数, res 配列) の全て
+ *
+ * @param[ref]  計算 (EphJcg; 係数読み込み済み)
+ * @param[in]   先頭時刻 (timespec)
+ * @return      operator new の呼び出し回数 (unsigned long)
+ */
+static unsigned long count_calc(ns::EphJcg& o_e, struct timespec t0) {
+  static constexpr long kStep = 3607;  // 時刻間隔（秒）
+  ns::Result res;
+  struct timespec ts;
+  unsigned long n0;
+  long i;
+
+  n0 = n_new.load();
+  for (i = 0; i < 365L * 86400 / kStep; ++i) {
+    ts.tv_sec  = t0.tv_sec + i * kStep;
+    ts.tv_nsec = (i * 7919) % 1000000000;
+    o_e.calc(ts, res);
+    o_e.calc(ts);
+    o_e.calc(&ts, 1, &res);
+  }
+
+  return n_new.load() - n0;
+}
+
+int main() {
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  ns::TruncStat trc = {};
+  ns::File o_f;
+  ns::DateTime dt = {2021, 1, 1, 0, 0, 0, 0};
+  unsigned long n;
+  int ret = EXIT_SUCCESS;
+
+  try {
+    o_f.get_param(dt.year, *prm);
+    {
+      ns::EphJcg o_e(*prm);
+      n = count_calc(o_e, ns::dt2ts(dt));
+      std::cout << (n == 0 ? "[OK] " : "[NG] ")
+                << "EphJcg::calc: " << n << " allocations" << std::endl;
+      if (n != 0) ret = EXIT_FAILURE;
+    }
+    ns::Trunc(1.0).calc(*prm, trc);
+    {
+      ns::EphJcg o_e(*prm);
+      n = count_calc(o_e, ns::dt2ts(dt));
+      std::cout << (n == 0 ? "[OK] " : "[NG] ")
+                << "EphJcg::calc (truncated): " << n << " allocations" << std::endl;
+      if (n != 0) ret = EXIT_FAILURE;
+    }
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return ret;
+}
@@ -0,0 +1,192 @@
+/***********************************************************
+  テスト: アーカイブ（archive）
+
+  * 列の符号化・復号（2階差分・ジグザグ符号化）が可逆であることを確認する。
+    （ビット列で比較; NaN, ±Inf, -0 を含む任意のビット列・滑らかな値・端数件数）
+  * アーカイブの書き込み・読み込みで EphJcg の計算結果と一致することを確認する。
+  * ヘッダの不正（時刻間隔 0, チャンク数と件数の不一致）を拒否することを確認する。
+***********************************************************/
+#include "archive.hpp"
+#include "eph_jcg.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns = ephemeris_jcg;
+
+static const std::string kArcF = "test/test_archive.arc";  // 作業用ファイル
+
+/*
+ * @brief      確認: 1列分の符号化・復号
+ *
+ * @param[in]  値の配列 (vector<double>)
+ * @return     true: 一致, false: 不一致
+ */
+static bool chk_col(const std::vector<double>& v) {
+  std::vector<unsigned char> enc;
+  std::vector<double> dec(v.size() + 1, 0.0);
+  const unsigned char* q;
+
+  ns::enc_col(v.data(), v.size(), enc);
+  q = ns::dec_col(enc.data(), enc.data() + enc.size(), v.size(), dec.data());
+  if (q != enc.data() + enc.size()) return false;
+  if (!v.empty() && std::memcmp(v.data(), dec.data(), v.size() * sizeof(double)) != 0) {
+    return false;
+  }
+  // 入力が不足する場合は失敗すること
+  if (!enc.empty() &&
+      ns::dec_col(enc.data(), enc.data() + enc.size() - 1, v.size(), dec.data())
+        != nullptr) {
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * @brief      確認: 不正なヘッダの拒否（子プロセスで読み込み、異常終了を期待）
+ *
+ * @param[in]  ファイルの内容 (string)
+ * @param[in]  ヘッダ (ArcHeader; 書き換え後)
+ * @return     true: 拒否された, false: 受け付けられた
+ */
+static bool chk_reject(const std::string& buf, const ns::ArcHeader& hdr) {
+  std::string b(buf);
+  pid_t pid;
+  int st;
+
+  std::memcpy(&b[0], &hdr, sizeof(hdr));
+  std::ofstream(kArcF, std::ios::binary | std::ios::trunc) << b;
+  std::cout.flush();
+  pid = fork();
+  if (pid == 0) {
+    std::freopen("/dev/null", "w", stdout);
+    ns::ArcReader o_r(kArcF);
+    ns::Result res;
+    o_r.get(o_r.size() - 1, res);
+    struct timespec ts = o_r.time(0);
+    o_r.get(ts, res);
+    _exit(EXIT_SUCCESS);
+  }
+  if (pid < 0 || waitpid(pid, &st, 0) != pid) return false;
+
+  return WIFEXITED(st) && WEXITSTATUS(st) == EXIT_FAILURE;
+}
+
+int main() {
+  static constexpr std::size_t kN     = 5000;  // 件数
+  static constexpr std::uint32_t kPer = 512;   // チャンクあたりの件数
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  std::mt19937_64 rng(20210101);
+  std::vector<double> v;
+  ns::File o_f;
+  ns::DateTime dt = {2021, 1, 1, 0, 0, 0, 0};
+  ns::Result r0;
+  ns::Result r1;
+  ns::ArcHeader hdr;
+  std::string buf;
+  struct timespec t0;
+  unsigned int n_ng = 0;
+  std::size_t n;
+  std::size_t i;
+
+  try {
+    // 符号化・復号
+    for (n = 0; n <= 5; ++n) {
+      v.assign(n, 0.0);
+      for (i = 0; i < n; ++i) {
+        std::uint64_t x = rng();
+        std::memcpy(&v[i], &x, sizeof(x));
+      }
+      if (!chk_col(v)) ++n_ng;
+    }
+    v.clear();
+    for (i = 0; i < 1001; ++i) {
+      std::uint64_t x = rng();
+      double d;
+      std::memcpy(&d, &x, sizeof(x));
+      v.push_back(d);
+    }
+    if (!chk_col(v)) ++n_ng;
+    v = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+         -std::numeric_limits<double>::infinity(),
+         std::numeric_limits<double>::quiet_NaN(),
+         std::numeric_limits<double>::denorm_min(),
+         std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+         1.0, -1.0, 0.0};
+    if (!chk_col(v)) ++n_ng;
+    v.clear();
+    for (i = 0; i < 3601; ++i) v.push_back(23.9 + std::sin(i * 1.0e-3) * 0.2);
+    if (!chk_col(v)) ++n_ng;
+    std::cout << (n_ng == 0 ? "[OK] " : "[NG] ")
+              << "enc_col/dec_col round trip" << std::endl;
+
+    // 書き込み・読み込み
+    o_f.get_param(dt.year, *prm);
+    t0 = ns::dt2ts(dt);
+    ns::write_archive(*prm, t0, 61LL * 1000000000, kN, kArcF, kPer, 2);
+    {
+      ns::EphJcg o_e(*prm);
+      ns::ArcReader o_r(kArcF);
+      unsigned int n_bad = 0;
+      if (o_r.size() != kN) ++n_bad;
+      for (i = 0; i < kN; i += 7) {
+        o_e.calc(o_r.time(i), r0);
+        if (!o_r.get(i, r1) || std::memcmp(&r0, &r1, sizeof(r0)) != 0) ++n_bad;
+      }
+      o_e.calc(o_r.time(kN - 1), r0);
+      if (!o_r.get(o_r.time(kN - 1), r1) || std::memcmp(&r0, &r1, sizeof(r0)) != 0) {
+        ++n_bad;
+      }
+      if (o_r.get(kN, r1)) ++n_bad;
+      std::cout << (n_bad == 0 ? "[OK] " : "[NG] ")
+                << "write_archive/ArcReader round trip" << std::endl;
+      n_ng += n_bad;
+    }
+
+    // 不正なヘッダ
+    {
+      std::ifstream ifs(kArcF, std::ios::binary);
+      buf.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    std::memcpy(&hdr, buf.data(), sizeof(hdr));
+    {
+      unsigned int n_bad = 0;
+      ns::ArcHeader h = hdr;
+      h.step_nsec = 0;
+      if (!chk_reject(buf, h)) ++n_bad;
+      h = hdr;
+      h.step_nsec = -1;
+      if (!chk_reject(buf, h)) ++n_bad;
+      h = hdr;
+      h.n = hdr.n + hdr.n_per_chunk;
+      if (!chk_reject(buf, h)) ++n_bad;
+      h = hdr;
+      h.n_chunk = hdr.n_chunk - 1;
+      if (!chk_reject(buf, h)) ++n_bad;
+      std::cout << (n_bad == 0 ? "[OK] " : "[NG] ")
+                << "ArcReader rejects invalid headers" << std::endl;
+      n_ng += n_bad;
+    }
+    std::remove(kArcF.c_str());
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return n_ng == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+/***********************************************************
+  テスト: 非同期計算（AsyncEph）
+
+  * 複数スレッドからの要求の結果（future）が、直接計算（EphJcg）と
+    一致することを確認する。
+  * バッチの件数が最大件数以下であることを確認する。
+  * 待ち時間の上限: 1件のみの要求は上限の経過後に、最大件数に達した要求は
+    上限を待たずに計算されることを確認する。
+  * 係数の無い年の要求は、future に std::out_of_range が設定されることを
+    確認する。
+  * デストラクタが受け付け済みの要求を全て計算することを確認する。
+***********************************************************/
+#include "async.hpp"
+#include "eph_jcg.hpp"
+#include "store.hpp"
+
+#include <chrono>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      時刻（テスト用）
+ *
+ * @param[in]  スレッド番号 (unsigned int)
+ * @param[in]  要求番号 (unsigned int)
+ * @return     UT1 (timespec)
+ */
+static struct timespec get_ts(unsigned int th, unsigned int i) {
+  // 2021-01-01 00:00:00 から、スレッド毎・要求毎にずらした時刻（2021 年内）
+  struct timespec ts = {1609459200 + static_cast<time_t>(th) * 7919
+                       + static_cast<time_t>(i) * 86413 % 31000000,
+                        static_cast<long>(i) * 1000003 % 1000000000};
+  return ts;
+}
+
+/*
+ * @brief      比較: 計算結果（全ての値）
+ *
+ * @param[in]  計算結果 (Result)
+ * @param[in]  計算結果 (Result)
+ * @return     一致 (bool)
+ */
+static bool is_same(const ns::Result& a, const ns::Result& b) {
+  for (unsigned int v = 0; v < ns::kNumVal; ++v) {
+    if (ns::get_val(a, v) != ns::get_val(b, v)) return false;
+  }
+  return true;
+}
+
+int main() {
+  static constexpr unsigned int kNumTh  = 8;    // スレッド数
+  static constexpr unsigned int kNumReq = 500;  // 要求数（スレッド毎）
+  static constexpr std::size_t  kNMax   = 64;   // バッチの最大件数
+  using clk = std::chrono::steady_clock;
+  using ms  = std::chrono::milliseconds;
+  ns::Store st;
+  int ret = EXIT_SUCCESS;
+
+  // 複数スレッドからの要求: 結果・バッチの件数
+  {
+    std::vector<std::vector<std::future<ns::Result>>> fut(kNumTh);
+    std::vector<std::thread> th;
+    unsigned int n_ng = 0;
+    std::size_t n_big;
+    std::unique_ptr<ns::AsyncEph> o_a(new ns::AsyncEph(st, kNMax, 500));
+    ns::EphJcg o_e(get_ts(0, 0));
+
+    for (unsigned int k = 0; k < kNumTh; ++k) {
+      th.emplace_back([&o_a, &fut, k]() {
+        for (unsigned int i = 0; i < kNumReq; ++i) {
+          fut[k].push_back(o_a->submit(get_ts(k, i)));
+        }
+      });
+    }
+    for (auto& x : th) x.join();
+    for (unsigned int k = 0; k < kNumTh; ++k) {
+      for (unsigned int i = 0; i < kNumReq; ++i) {
+        ns::Result res;
+        o_e.calc(get_ts(k, i), res);
+        if (fut[k][i].wait_for(ms(5000)) != std::future_status::ready ||
+            !is_same(fut[k][i].get(), res)) ++n_ng;
+      }
+    }
+    n_big = o_a->get_max_batch();
+    if (n_ng > 0 || o_a->get_n_req() != kNumTh * kNumReq) {
+      std::cout << "[NG] async: " << n_ng << " / " << kNumTh * kNumReq
+                << " mismatched" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] async: " << kNumTh * kNumReq << " futures in "
+                << o_a->get_n_batch() << " batches" << std::endl;
+    }
+    if (n_big == 0 || n_big > kNMax) {
+      std::cout << "[NG] async: max batch " << n_big << " > " << kNMax
+                << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] async: max batch " << n_big << " <= " << kNMax
+                << std::endl;
+    }
+  }
+
+  // 待ち時間の上限
+  {
+    ns::AsyncEph o_a(st, kNMax, 200000);    // 上限 200 ms
+    clk::time_point t0 = clk::now();
+    std::future<ns::Result> f = o_a.submit(get_ts(0, 0));
+    bool ok = f.wait_for(ms(5000)) == std::future_status::ready;
+    long el = std::chrono::duration_cast<ms>(clk::now() - t0).count();
+
+    if (!ok || el < 190 || el > 2000) {
+      std::cout << "[NG] async: single request in " << el << " ms" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] async: single request in " << el << " ms" << std::endl;
+    }
+  }
+  {
+    ns::AsyncEph o_a(st, kNMax, 60000000);  // 上限 60 s
+    std::vector<std::future<ns::Result>> f;
+    clk::time_point t0 = clk::now();
+    bool ok = true;
+
+    for (unsigned int i = 0; i < kNMax; ++i) f.push_back(o_a.submit(get_ts(1, i)));
+    for (auto& x : f) ok = ok && x.wait_for(ms(5000)) == std::future_status::ready;
+    long el = std::chrono::duration_cast<ms>(clk::now() - t0).count();
+    if (!ok || el > 2000) {
+      std::cout << "[NG] async: full batch in " << el << " ms" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] async: full batch in " << el << " ms" << std::endl;
+    }
+  }
+
+  // 係数の無い年、デストラクタでの計算
+  {
+    std::future<ns::Result> f_ng;
+    std::future<ns::Result> f_ok;
+    bool ok = false;
+
+    {
+      ns::AsyncEph o_a(st, kNMax, 60000000);  // 上限 60 s
+      struct timespec ts_ng = {0, 0};         // 1970-01-01
+      f_ng = o_a.submit(ts_ng);
+      f_ok = o_a.submit(get_ts(2, 0));
+    }
+    if (f_ng.wait_for(ms(0)) == std::future_status::ready &&
+        f_ok.wait_for(ms(0)) == std::future_status::ready) {
+      try {
+        f_ng.get();
+      } catch (const std::out_of_range&) {
+        ok = true;
+      }
+      try {
+        f_ok.get();
+      } catch (...) {
+        ok = false;
+      }
+    }
+    if (!ok) {
+      std::cout << "[NG] async: out_of_range / drain on destruction" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] async: out_of_range / drain on destruction" << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,201 @@
+/***********************************************************
+  テスト: 計算結果のキャッシュ（Cache）
+
+  * ミス・ヒットの回数と、値が量子化した時刻での直接計算（EphJcg）と
+    一致することを確認する。
+  * 容量を超えて登録しても、ヒットするエントリが容量以下であることを
+    確認する。（置き換え）
+  * 値の指定外は変更しないことを確認する。
+  * 係数の再読み込み（Store::reload）後は、同じ時刻でもミスとなることを
+    確認する。（一時ディレクトリの txt/ のファイルを更新）
+***********************************************************/
+#include "cache.hpp"
+#include "eph_jcg.hpp"
+#include "store.hpp"
+
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      比較: 計算結果（全ての値）
+ *
+ * @param[in]  計算結果 (Result)
+ * @param[in]  計算結果 (Result)
+ * @return     一致 (bool)
+ */
+static bool is_same(const ns::Result& a, const ns::Result& b) {
+  for (unsigned int v = 0; v < ns::kNumVal; ++v) {
+    if (ns::get_val(a, v) != ns::get_val(b, v)) return false;
+  }
+  return true;
+}
+
+int main() {
+  static constexpr char kF21[] = "txt/na21-data.txt";  // 更新するファイル
+  static constexpr std::size_t kNMax = 64;            // 容量
+  static constexpr std::time_t kT0   = 1609459200;    // 2021-01-01 00:00:00
+  std::vector<std::string> fs;                        // txt/ 内のファイル
+  std::string org;                                    // 元の内容
+  char cwd[4096];
+  char dir[] = "/tmp/test_cache_XXXXXX";
+  DIR* dp;
+  struct dirent* ent;
+  int ret = EXIT_SUCCESS;
+
+  // 一時ディレクトリ（txt/ 内のファイルへのリンク）
+  if (getcwd(cwd, sizeof(cwd)) == nullptr || mkdtemp(dir) == nullptr) {
+    std::cout << "[NG] Cache: could not create a temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  dp = opendir("txt");
+  while (dp != nullptr && (ent = readdir(dp)) != nullptr) {
+    if (ent->d_name[0] != '.') fs.push_back(ent->d_name);
+  }
+  if (dp != nullptr) closedir(dp);
+  {
+    std::ifstream ifs(kF21, std::ios::binary);
+    org.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  if (chdir(dir) != 0 || mkdir("txt", 0700) != 0) {
+    std::cout << "[NG] Cache: could not enter " << dir << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (auto& f : fs) {
+    if (symlink((std::string(cwd) + "/txt/" + f).c_str(), ("txt/" + f).c_str()) != 0) {
+      std::cout << "[NG] Cache: could not link " << f << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    ns::Store st;
+    ns::Cache o_c(st, 1000000000, kNMax, 1);        // 1 秒単位, 1 ストライプ
+    std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数（2021 年）
+    {
+      ns::Store::Reader rd(st);
+      *prm = *rd.find(2021);
+    }
+    ns::EphJcg o_e(*prm);
+    ns::Result res;
+    ns::Result r_e;
+    unsigned int n_ng = 0;
+    std::uint64_t i;
+    std::uint64_t n_hit;
+
+    // ミス・ヒット（直後の同じ秒内の時刻はヒット）
+    for (i = 0; i < kNMax / 2; ++i) {
+      struct timespec ts = {kT0 + static_cast<std::time_t>(i) * 3600, 0};
+      struct timespec tn = {ts.tv_sec, 999999999};
+      o_c.get(ts, ns::kMaskAll, res);
+      o_e.calc(ts, r_e);
+      if (!is_same(res, r_e)) ++n_ng;
+      o_c.get(tn, ns::kMaskAll, res);
+      if (!is_same(res, r_e)) ++n_ng;
+    }
+    if (n_ng > 0 || o_c.get_n_miss() != kNMax / 2 || o_c.get_n_hit() != kNMax / 2) {
+      std::cout << "[NG] Cache: hit " << o_c.get_n_hit() << ", miss "
+                << o_c.get_n_miss() << ", " << n_ng << " mismatched" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Cache: " << kNMax / 2 << " misses then "
+                << kNMax / 2 << " hits" << std::endl;
+    }
+
+    // 値の指定
+    {
+      struct timespec ts = {kT0, 0};
+      std::memset(&res, 0, sizeof(res));
+      o_c.get(ts, 1ULL << ns::kValMonDec, res);
+      o_e.calc(ts, r_e);
+      bool ok = res.mon_dec == r_e.mon_dec;
+      for (unsigned int v = 0; v < ns::kNumVal; ++v) {
+        if (v != ns::kValMonDec && ns::get_val(res, v) != 0.0) ok = false;
+      }
+      if (!ok) {
+        std::cout << "[NG] Cache: mask" << std::endl;
+        ret = EXIT_FAILURE;
+      } else {
+        std::cout << "[OK] Cache: mask copies only the selected value" << std::endl;
+      }
+    }
+
+    // 容量（4倍の時刻を登録し、全てを再取得してもヒットは容量以下）
+    o_c.clear();
+    for (i = 0; i < 4 * kNMax; ++i) {
+      struct timespec ts = {kT0 + static_cast<std::time_t>(i) * 60, 0};
+      o_c.get(ts, ns::kMaskAll, res);
+    }
+    n_hit = o_c.get_n_hit();
+    for (i = 0; i < 4 * kNMax; ++i) {
+      struct timespec ts = {kT0 + static_cast<std::time_t>(i) * 60, 0};
+      o_c.get(ts, ns::kMaskAll, res);
+    }
+    n_hit = o_c.get_n_hit() - n_hit;
+    if (o_c.capacity() != kNMax || n_hit > kNMax) {
+      std::cout << "[NG] Cache: " << n_hit << " hits > capacity "
+                << o_c.capacity() << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Cache: " << n_hit << " hits <= capacity "
+                << o_c.capacity() << " after eviction" << std::endl;
+    }
+
+    // 再読み込み後はミス
+    {
+      struct timespec ts = {kT0 + 4 * static_cast<std::time_t>(kNMax - 1) * 60, 0};
+      std::uint64_t n_miss;
+      bool ok;
+      o_c.get(ts, ns::kMaskAll, res);
+      n_miss = o_c.get_n_miss();
+      o_c.get(ts, ns::kMaskAll, res);
+      ok = o_c.get_n_miss() == n_miss;  // 再読み込み前はヒット
+      unlink(kF21);
+      {
+        std::ofstream ofs(kF21, std::ios::binary);
+        ofs << org;
+      }
+      ok = ok && st.reload();
+      o_c.get(ts, ns::kMaskAll, res);
+      o_e.calc(ts, r_e);
+      ok = ok && o_c.get_n_miss() == n_miss + 1 && is_same(res, r_e);
+      o_c.get(ts, ns::kMaskAll, res);
+      ok = ok && o_c.get_n_miss() == n_miss + 1;
+      if (!ok) {
+        std::cout << "[NG] Cache: miss after Store::reload" << std::endl;
+        ret = EXIT_FAILURE;
+      } else {
+        std::cout << "[OK] Cache: miss after Store::reload, then hit" << std::endl;
+      }
+    }
+
+    // 係数の無い年
+    {
+      struct timespec ts = {0, 0};
+      if (o_c.get(ts, ns::kMaskAll, res)) {
+        std::cout << "[NG] Cache: 1970 returned a result" << std::endl;
+        ret = EXIT_FAILURE;
+      } else {
+        std::cout << "[OK] Cache: 1970 not loaded" << std::endl;
+      }
+    }
+  }
+
+  // 後始末
+  for (auto& f : fs) unlink(("txt/" + f).c_str());
+  rmdir("txt");
+  if (chdir(cwd) == 0) rmdir(dir);
+
+  return ret;
+}
@@ -0,0 +1,106 @@
+/***********************************************************
+  テスト: 天測位置（CelFix）の収束
+
+  * 既知の位置（多数の船舶）での観測高度 Ho を生成し、推測位置から
+    解いた船位が既知の位置に一致することを確認する。
+    - 太陽は下辺（中心の高度 - 視半径）で生成する。
+    - 月は下辺・上辺を交互に（Topo の周縁補正で）生成する。
+    - 惑星は中心で生成する。
+  * 観測は 2 時間毎、高度 10° 以上のもの。（船舶は停止しているものとする）
+***********************************************************/
+#include "eph_jcg.hpp"
+#include "fix.hpp"
+#include "topo.hpp"
+
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+int main() {
+  static constexpr unsigned int kNumTm  = 12;     // 観測時刻数
+  static constexpr long         kStep   = 7200;   // 観測間隔（秒）
+  static constexpr double       kAltMin = 10.0;   // 観測高度の下限（°）
+  static constexpr double       kDLat   = 0.4;    // 推測位置の誤差: 緯度（°）
+  static constexpr double       kDLon   = -0.5;   // 推測位置の誤差: 経度（°）
+  static constexpr double       kTol    = 0.1;    // 許容誤差（′）
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  std::vector<double> lat, lon;                    // 既知の位置
+  std::vector<double> lat0, lon0;                  // 推測位置
+  std::vector<double> hc, h_c, zn;                 // 高度（周縁）, 高度（中心）, 方位角
+  std::vector<ns::Sight> sgt;                      // 観測
+  std::vector<ns::Fix> fix;                        // 船位
+  ns::File o_f;
+  ns::CelFix o_c;
+  ns::DateTime dt = {2021, 3, 10, 0, 0, 0, 0};
+  ns::Result res;
+  ns::Sight s;
+  unsigned long n_ng = 0;
+  unsigned long n_limb = 0;
+  unsigned int k;
+  unsigned int b;
+  std::size_t v;
+
+  try {
+    for (int la = -50; la <= 50; la += 25) {
+      for (int lo = -150; lo <= 150; lo += 60) {
+        lat.push_back(la);
+        lon.push_back(lo);
+        lat0.push_back(la + kDLat);
+        lon0.push_back(lo + kDLon);
+      }
+    }
+    ns::Topo o_t(lat.data(), lon.data(), nullptr, lat.size());
+    hc.resize(o_t.size());
+    h_c.resize(o_t.size());
+    zn.resize(o_t.size());
+    o_f.get_param(dt.year, *prm);
+    ns::EphJcg o_e(*prm);
+    for (k = 0; k < kNumTm; ++k) {
+      s.ut1 = ns::dt2ts(dt);
+      s.ut1.tv_sec += k * kStep;
+      o_e.calc(s.ut1, res);
+      for (b = 0; b < ns::kNumBody; ++b) {
+        s.body = b;
+        s.limb = ns::kLimbCenter;
+        if (b == ns::kGrpSun) s.limb = ns::kLimbLower;
+        if (b == ns::kGrpMon) s.limb = (k % 2) ? ns::kLimbUpper : ns::kLimbLower;
+        o_t.calc_body(res, b, h_c.data(), zn.data(), ns::kLimbCenter);
+        o_t.calc_body(res, b, hc.data(), zn.data(), s.limb);
+        for (v = 0; v < o_t.size(); ++v) {
+          if (h_c[v] < kAltMin) continue;
+          s.vsl = v;
+          s.ho  = (b == ns::kGrpSun) ? h_c[v] - res.sun_sd / 60.0 : hc[v];
+          if (s.limb != ns::kLimbCenter) ++n_limb;
+          sgt.push_back(s);
+        }
+      }
+    }
+    o_c.calc(sgt, lat0.data(), lon0.data(), lat.size(), fix);
+    for (v = 0; v < fix.size(); ++v) {
+      double e_lat = (fix[v].lat - lat[v]) * 60.0;
+      double e_lon = std::remainder(fix[v].lon - lon[v], 360.0) * 60.0
+                   * std::cos(lat[v] * std::atan(1.0) / 45.0);
+      double err = std::sqrt(e_lat * e_lat + e_lon * e_lon);
+      if (!fix[v].ok || err > kTol || fix[v].rms > kTol) {
+        ++n_ng;
+        std::cout << "  vessel " << v << " (" << lat[v] << ", " << lon[v]
+                  << "): ok = " << fix[v].ok << ", error = " << err
+                  << "′, rms = " << fix[v].rms << "′, sights = "
+                  << fix[v].n_sight << std::endl;
+      }
+    }
+    std::cout << (n_ng == 0 ? "[OK] " : "[NG] ") << "CelFix: "
+              << n_ng << " / " << fix.size() << " failed ("
+              << sgt.size() << " sights, " << n_limb << " limb)" << std::endl;
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return n_ng == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
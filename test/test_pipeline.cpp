@@ -0,0 +1,208 @@
+/***********************************************************
+  テスト: 時刻の解析（parse_ut1, parse_iso8601）・一括計算（Pipeline）
+
+  * 存在しない日付（2020-02-30 等）・範囲外の値を書式エラーとし、
+    時差付きの ISO-8601 を UT に換算することを確認する。
+  * 複数バッチ（kPipeLines 行超）・複数スレッドでも入力順に出力され、
+    値が直接計算（EphJcg）と一致することを確認する。
+  * CRLF・コメント・空行を無視し、書式エラー・係数の無い年の行数、
+    kPipeRead を超える長さの行を正しく扱うことを確認する。
+***********************************************************/
+#include "common.hpp"
+#include "eph_jcg.hpp"
+#include "pipeline.hpp"
+#include "store.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      時刻の解析（文字列指定）
+ *
+ * @param[in]  文字列 (string)
+ * @param[ref] UT1 (timespec)
+ * @return     true: 成功, false: 書式エラー
+ */
+static bool parse(const std::string& s, struct timespec& ts) {
+  return ns::parse_time(s.c_str(), s.size(), ts);
+}
+
+/*
+ * @brief      解析のテスト
+ *
+ * @param[in]  <none>
+ * @return     失敗数 (unsigned int)
+ */
+static unsigned int test_parse() {
+  static const char* kBad[] = {
+    "2020-02-30", "2021-02-29", "2021-04-31", "2100-02-29", "2021-13-01",
+    "2021-00-10", "2021-01-00", "2021-01-32", "2021-01-01T24:00",
+    "2021-01-01T12:60", "2021-01-01T12:00:61", "2021-01-01T12:00:00.",
+    "2021-01-01T12:00+24:00", "2021-01-01X", "20200230", "20210229",
+    "20210431", "20211301", "2021010124", "202", "2021a",
+  };
+  struct timespec ts;
+  struct timespec tz;
+  unsigned int n_ng = 0;
+
+  for (auto s : kBad) {
+    if (parse(s, ts)) {
+      std::cout << "[NG] parse: \"" << s << "\" accepted" << std::endl;
+      ++n_ng;
+    }
+  }
+  // 閏日・閏秒・部分指定・時差
+  if (!parse("2020-02-29", ts) || ts.tv_sec != 1582934400) ++n_ng;
+  if (!parse("20200229", ts) || ts.tv_sec != 1582934400) ++n_ng;
+  if (!parse("2000-02-29T00:00:00Z", ts) || ts.tv_sec != 951782400) ++n_ng;
+  if (!parse("2016-12-31T23:59:60", ts)) ++n_ng;
+  if (!parse("2021", ts) || ts.tv_sec != 1609459200 || ts.tv_nsec != 0) ++n_ng;
+  if (!parse("20210101000000123", ts) || ts.tv_nsec != 123000000) ++n_ng;
+  if (!parse("2021-01-01T09:00:00.5+09:00", tz) ||
+      !parse("2021-01-01T00:00:00.5", ts) ||
+      tz.tv_sec != ts.tv_sec || tz.tv_nsec != 500000000) ++n_ng;
+  if (!parse("2021-01-01 00:00-0130", tz) || tz.tv_sec != 1609459200 + 5400) ++n_ng;
+
+  return n_ng;
+}
+
+int main() {
+  static constexpr unsigned int kNumTm = 10000;         // 有効な時刻の数
+  static constexpr std::time_t  kT0    = 1609459200;    // 2021-01-01 00:00:00
+  static constexpr std::time_t  kStep  = 3107;          // 時刻の間隔（秒）
+  ns::Store st;
+  std::vector<struct timespec> ts_in;  // 入力した有効な時刻
+  std::string in;                      // 入力
+  std::string out;                     // 出力
+  std::ostringstream sink;             // 警告（標準エラー出力）の退避先
+  unsigned int n_bad = 0;              // 入力した書式エラーの行数
+  unsigned int n_skip = 0;             // 入力した係数の無い年の行数
+  unsigned int n_ng;
+  unsigned int i;
+  char buf[64];
+  int ret = EXIT_SUCCESS;
+
+  // 解析
+  n_ng = test_parse();
+  if (n_ng > 0) {
+    std::cout << "[NG] parse_ut1/parse_iso8601: " << n_ng << " failed" << std::endl;
+    ret = EXIT_FAILURE;
+  } else {
+    std::cout << "[OK] parse_ut1/parse_iso8601" << std::endl;
+  }
+
+  // 入力（有効な時刻の間に、無視する行・エラーの行を挟む）
+  for (i = 0; i < kNumTm; ++i) {
+    struct timespec ts = {kT0 + static_cast<std::time_t>(i) * kStep,
+                          static_cast<long>(i) * 100003 % 1000000000};
+    ns::DateTime dt = ns::ts2dt(ts);
+    if (i % 2 == 0) {
+      std::snprintf(buf, sizeof(buf), "%04d%02u%02u%02u%02u%02u%09u", dt.year,
+                    dt.month, dt.day, dt.hour, dt.min, dt.sec, dt.nsec);
+    } else {
+      std::snprintf(buf, sizeof(buf), "%04d-%02u-%02uT%02u:%02u:%02u.%09u", dt.year,
+                    dt.month, dt.day, dt.hour, dt.min, dt.sec, dt.nsec);
+    }
+    in += (i % 3 == 0) ? std::string("  ") + buf + " \r\n" : std::string(buf) + "\n";
+    ts_in.push_back(ts);
+    switch (i % 1000) {
+      case 1:   in += "\n";                     break;
+      case 2:   in += "# comment\r\n";          break;
+      case 3:   in += "   \t \r\n";             break;
+      case 4:   in += "2020-02-30\n"; ++n_bad;  break;
+      case 5:   in += "2021-13-01\r\n"; ++n_bad;  break;
+      case 6:   in += "19990101\n"; ++n_skip;   break;
+      case 7:   in += "2030-06-01T00:00Z\n"; ++n_skip;  break;
+      default:  break;
+    }
+    if (i == kNumTm / 2) {
+      in += "#" + std::string(ns::kPipeRead + 12345, 'c') + "\n";
+      in += std::string(ns::kPipeRead * 2 + 7, '9') + "\n";
+      ++n_bad;
+    }
+  }
+
+  // 実行
+  {
+    std::FILE* f_in  = std::tmpfile();
+    std::FILE* f_out = std::tmpfile();
+    std::streambuf* sb = std::cerr.rdbuf(sink.rdbuf());
+    ns::Pipeline o_p(st, 3);
+    long n;
+    std::fwrite(in.data(), 1, in.size(), f_in);
+    std::rewind(f_in);
+    o_p.run(f_in, f_out);
+    std::cerr.rdbuf(sb);
+    n = std::ftell(f_out);
+    std::rewind(f_out);
+    out.resize(n);
+    if (std::fread(&out[0], 1, n, f_out) != static_cast<std::size_t>(n)) out.clear();
+    std::fclose(f_in);
+    std::fclose(f_out);
+    if (o_p.get_n_out() != kNumTm || o_p.get_n_bad() != n_bad ||
+        o_p.get_n_skip() != n_skip) {
+      std::cout << "[NG] Pipeline: out " << o_p.get_n_out() << "/" << kNumTm
+                << ", bad " << o_p.get_n_bad() << "/" << n_bad
+                << ", skip " << o_p.get_n_skip() << "/" << n_skip << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Pipeline: " << kNumTm << " out, " << n_bad << " bad, "
+                << n_skip << " skipped (CRLF, comments, blank, long lines)"
+                << std::endl;
+    }
+  }
+
+  // 出力（入力順・値）
+  {
+    std::istringstream iss(out);
+    std::string ln;
+    std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数（2021 年）
+    {
+      ns::Store::Reader rd(st);
+      *prm = *rd.find(2021);
+    }
+    ns::EphJcg o_e(*prm);
+    ns::Result res;
+    n_ng = 0;
+    std::getline(iss, ln);  // 見出し
+    for (i = 0; i < kNumTm && std::getline(iss, ln); ++i) {
+      ns::DateTime dt = ns::ts2dt(ts_in[i]);
+      std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u %02u:%02u:%02u.%09u,", dt.year,
+                    dt.month, dt.day, dt.hour, dt.min, dt.sec, dt.nsec);
+      if (ln.compare(0, 30, buf) != 0) {
+        ++n_ng;
+        continue;
+      }
+      o_e.calc(ts_in[i], res);
+      std::istringstream cs(ln.substr(30));
+      std::string c;
+      for (unsigned int v = 0; v < ns::kNumVal && std::getline(cs, c, ','); ++v) {
+        if (std::abs(std::stod(c) - ns::get_val(res, v)) > 0.6e-8) {
+          ++n_ng;
+          break;
+        }
+      }
+    }
+    if (n_ng > 0 || i != kNumTm || std::getline(iss, ln)) {
+      std::cout << "[NG] Pipeline order/values: " << n_ng << " / " << i
+                << " mismatched" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Pipeline order/values across "
+                << (kNumTm + ns::kPipeLines - 1) / ns::kPipeLines
+                << "+ batches" << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,166 @@
+/***********************************************************
+  テスト: 出没・薄明（RiseSet）
+
+  * 2020-06-21（夏至）の東京・シドニーの日の出・日の入・常用薄明の時刻が
+    公表値（分単位）と 1 分以内で一致することを確認する。
+  * 白夜（トロムソ）・極夜（マクマード）の日は、日の出・日の入が無く、
+    太陽が地平線上にある期間が 終日・無し となることを確認する。
+  * 年をまたぐ期間（2020-12-30 - 2021-01-02）で、日の出・日の入が毎日
+    求まり、各時刻の前後 1 秒で（節点の補間を用いない直接計算の）高度が
+    基準高度をまたぐことを確認する。
+***********************************************************/
+#include "common.hpp"
+#include "eph_jcg.hpp"
+#include "eph_year.hpp"
+#include "riseset.hpp"
+
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+// 定数
+static constexpr double kPi  = atan(1.0) * 4;  // PI
+static constexpr double kD2R = kPi / 180.0;    // 度 -> ラジアン
+
+// 公表値（時刻: 地方時の 0 時からの分）
+struct Pub {
+  unsigned int loc;  // 観測地点番号
+  unsigned int evt;  // 現象（Evt）
+  unsigned int min;  // 時刻（分）
+};
+
+/*
+ * @brief      計算: 太陽の中心の高度 - 出没の基準高度（直接計算）
+ *             * 基準高度は -(34′+ 視半径) + 地平視差。（RiseSet と同じ定義）
+ *
+ * @param[ref] 年毎の計算 (EphYear)
+ * @param[in]  緯度（°） (double)
+ * @param[in]  経度（°） (double)
+ * @param[in]  時刻（UT1; 秒） (double)
+ * @return     高度 - 基準高度（°） (double)
+ */
+static double calc_e(ns::EphYear& eph, double lat, double lon, double t) {
+  struct timespec ts;
+  ns::Result res;
+  double sin_a;
+
+  ts.tv_sec  = static_cast<std::time_t>(std::floor(t));
+  ts.tv_nsec = static_cast<long>((t - std::floor(t)) * 1.0e9);
+  eph.get(ns::ts2dt(ts).year).calc(ts, res);
+  sin_a = sin(lat * kD2R) * sin(res.sun_dec * kD2R)
+        + cos(lat * kD2R) * cos(res.sun_dec * kD2R)
+        * cos((res.sun_hg * 15.0 + lon) * kD2R);
+
+  return asin(sin_a) / kD2R
+       + 34.0 / 60.0 + res.sun_sd / 60.0 - 8.794143 / 3600.0 / res.sun_dist;
+}
+
+int main() {
+  static constexpr std::time_t kT0 = 1592697600;  // 2020-06-21 00:00:00 UTC
+  // 東京, シドニー, トロムソ, マクマード
+  const double lat[] = { 35.6500, -33.8667,  69.6500, -77.8500};
+  const double lon[] = {139.7500, 151.2000,  18.9500, 166.6667};
+  const double tz[]  = {9.0, 10.0};  // 時差（h; 東京, シドニー）
+  const Pub pub[] = {
+    {0, ns::kEvtSunRise,    4 * 60 + 25}, {0, ns::kEvtSunSet,    19 * 60 +  0},
+    {0, ns::kEvtCivilBgn,   3 * 60 + 55}, {0, ns::kEvtCivilEnd,  19 * 60 + 30},
+    {1, ns::kEvtSunRise,    7 * 60 +  0}, {1, ns::kEvtSunSet,    16 * 60 + 54},
+    {1, ns::kEvtCivilBgn,   6 * 60 + 32}, {1, ns::kEvtCivilEnd,  17 * 60 + 22},
+  };
+  std::vector<ns::Event> evts;
+  std::vector<ns::Window> wins;
+  int ret = EXIT_SUCCESS;
+
+  // 公表値（観測地点毎に地方時の 0 時から 1 日）
+  for (unsigned int loc = 0; loc < 2; ++loc) {
+    ns::RiseSet o_r(&lat[loc], &lon[loc], 1);
+    struct timespec t0 = {kT0 - static_cast<std::time_t>(tz[loc] * 3600), 0};
+    unsigned int n_ng = 0;
+    o_r.calc(t0, 1, evts, wins);
+    for (auto& p : pub) {
+      if (p.loc != loc) continue;
+      unsigned int n = 0;
+      for (auto& e : evts) {
+        if (e.evt != p.evt) continue;
+        ++n;
+        if (std::fabs(e.t - t0.tv_sec - p.min * 60.0) > 60.0) {
+          std::cout << "[NG] RiseSet: loc " << loc << ", evt " << p.evt << ": "
+                    << (e.t - t0.tv_sec) / 60.0 << " min (published "
+                    << p.min << ")" << std::endl;
+          ++n_ng;
+        }
+      }
+      if (n != 1) ++n_ng;
+    }
+    if (n_ng > 0) {
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] RiseSet: " << (loc == 0 ? "Tokyo" : "Sydney")
+                << " 2020-06-21 sunrise/sunset/civil twilight within 1 min"
+                << std::endl;
+    }
+  }
+
+  // 白夜・極夜
+  {
+    ns::RiseSet o_r(&lat[2], &lon[2], 2);
+    struct timespec t0 = {kT0, 0};
+    bool ok = true;
+    unsigned int n_win[2] = {0, 0};
+    o_r.calc(t0, 1, evts, wins);
+    for (auto& e : evts) {
+      if (e.evt == ns::kEvtSunRise || e.evt == ns::kEvtSunSet) ok = false;
+      if (e.loc == 0 && e.evt < ns::kEvtMonRise) ok = false;  // 白夜: 薄明も無し
+    }
+    for (auto& w : wins) {
+      if (w.body != ns::kGrpSun) continue;
+      ++n_win[w.loc];
+      if (w.bgn != kT0 || std::fabs(w.end - (kT0 + 86400)) > 0.01) ok = false;
+    }
+    if (!ok || n_win[0] != 1 || n_win[1] != 0) {
+      std::cout << "[NG] RiseSet: polar day/night" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] RiseSet: polar day (Tromso) / polar night (McMurdo)"
+                << std::endl;
+    }
+  }
+
+  // 年をまたぐ期間（東京）
+  {
+    ns::RiseSet o_r(&lat[0], &lon[0], 1);
+    ns::EphYear eph;
+    struct timespec t0 = {1609254000, 0};  // 2020-12-30 00:00:00 JST
+    unsigned int n_evt[2] = {0, 0};
+    unsigned int n_win = 0;
+    unsigned int n_ng = 0;
+    o_r.calc(t0, 4, evts, wins);
+    for (auto& w : wins) {
+      if (w.body == ns::kGrpSun) ++n_win;
+    }
+    for (auto& e : evts) {
+      if (e.evt != ns::kEvtSunRise && e.evt != ns::kEvtSunSet) continue;
+      ++n_evt[e.evt];
+      double e0 = calc_e(eph, lat[0], lon[0], e.t - 1.0);
+      double e1 = calc_e(eph, lat[0], lon[0], e.t + 1.0);
+      if ((e0 < 0.0) == (e1 < 0.0) || (e1 < 0.0) != (e.evt == ns::kEvtSunSet)) {
+        ++n_ng;
+      }
+    }
+    if (n_ng > 0 || n_evt[0] != 4 || n_evt[1] != 4 || n_win != 4) {
+      std::cout << "[NG] RiseSet: across the year boundary: " << n_evt[0]
+                << " rises, " << n_evt[1] << " sets, " << n_ng << " off"
+                << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] RiseSet: 2020-12-30 - 2021-01-02 rises/sets within 1 s"
+                << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,110 @@
+/***********************************************************
+  テスト: 食・星食の候補の検索（Screen）
+
+  * 2020 年の日食（2回）・月食（半影食を含む4回）が全て候補となり、
+    最接近の時刻が公表値（食の最大）と 1 分以内で一致することを確認する。
+    （公表値は NASA の食の最大（TD）から ΔT = 69 s を減じた UT）
+  * 複数年（2018 - 2019）を続けて計算しても、係数の重なる年末・年始の
+    候補が重複せず、最接近が全て対象年内であることを確認する。
+***********************************************************/
+#include "common.hpp"
+#include "file.hpp"
+#include "screen.hpp"
+
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+// 公表値（食の最大; UT）
+struct Pub {
+  unsigned int kind;  // 種類（Ecl）
+  ns::DateTime dt;    // 食の最大（UT）
+};
+
+int main() {
+  const Pub pub[] = {
+    {ns::kEclSolar, {2020,  6, 21,  6, 40,  6, 0}},  // 金環日食
+    {ns::kEclSolar, {2020, 12, 14, 16, 13, 30, 0}},  // 皆既日食
+    {ns::kEclLunar, {2020,  1, 10, 19, 10,  2, 0}},  // 半影月食
+    {ns::kEclLunar, {2020,  6,  5, 19, 25,  3, 0}},  // 半影月食
+    {ns::kEclLunar, {2020,  7,  5,  4, 30,  3, 0}},  // 半影月食
+    {ns::kEclLunar, {2020, 11, 30,  9, 42, 52, 0}},  // 半影月食
+  };
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  ns::File o_f;
+  int ret = EXIT_SUCCESS;
+
+  // 2020 年の日食・月食
+  {
+    std::vector<ns::EclCand> cand;
+    ns::Screen o_s;
+    unsigned int n_ecl = 0;
+    unsigned int n_ng = 0;
+    o_f.get_param(2020, *prm);
+    o_s.calc(*prm, cand);
+    for (auto& c : cand) {
+      if (c.kind == ns::kEclSolar || c.kind == ns::kEclLunar) ++n_ecl;
+    }
+    for (auto& p : pub) {
+      struct timespec ts = ns::dt2ts(p.dt);
+      unsigned int n = 0;
+      for (auto& c : cand) {
+        if (c.kind != p.kind) continue;
+        double d = (c.max.tv_sec - ts.tv_sec) + c.max.tv_nsec * 1.0e-9;
+        if (std::fabs(d) > 86400.0) continue;
+        ++n;
+        if (std::fabs(d) > 60.0 || c.sep >= c.lim) {
+          std::cout << "[NG] Screen: " << ns::gen_time_str(c.max) << " is "
+                    << d << " s off" << std::endl;
+          ++n_ng;
+        }
+      }
+      if (n != 1) ++n_ng;
+    }
+    if (n_ng > 0 || n_ecl != sizeof(pub) / sizeof(pub[0])) {
+      std::cout << "[NG] Screen: 2020 eclipses: " << n_ecl << " found, "
+                << n_ng << " mismatched" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Screen: 2020 solar/lunar eclipse maxima within 1 min"
+                << std::endl;
+    }
+  }
+
+  // 複数年（2018 - 2019）
+  {
+    std::vector<ns::EclCand> cand;
+    ns::Screen o_s;
+    std::size_t n_18;
+    unsigned int n_ng = 0;
+    std::size_t i;
+    std::size_t j;
+    o_f.get_param(2018, *prm);
+    o_s.calc(*prm, cand);
+    n_18 = cand.size();
+    o_f.get_param(2019, *prm);
+    o_s.calc(*prm, cand);
+    for (i = 0; i < cand.size(); ++i) {
+      if (ns::ts2dt(cand[i].max).year != (i < n_18 ? 2018 : 2019)) ++n_ng;
+      for (j = i + 1; j < cand.size(); ++j) {
+        if (cand[i].kind == cand[j].kind &&
+            std::labs(cand[i].max.tv_sec - cand[j].max.tv_sec) < 86400) ++n_ng;
+      }
+    }
+    if (n_ng > 0 || n_18 == 0 || n_18 == cand.size()) {
+      std::cout << "[NG] Screen: 2018-2019: " << n_ng << " duplicated / out of year"
+                << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Screen: 2018-2019: " << cand.size()
+                << " candidates, no duplicates" << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,158 @@
+/***********************************************************
+  テスト: 共有メモリへの公開（ShmPub, ShmSub）
+
+  * 公開前は read() が false となり、公開した UT1・計算結果がそのまま
+    読み取れることを確認する。
+  * 公開側のスレッドが書き込み続ける間に購読側が読み取り、途中の値
+    （異なる公開の値の混在）を読まないことを確認する。（seqlock）
+  * 存在しない・小さすぎる・識別子の異なる共有メモリは、購読側が
+    エラー終了することを確認する。（SIGBUS とならない）
+***********************************************************/
+#include "shm.hpp"
+#include "shm_sub.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      計算結果（テスト用; 全ての値を k とする）
+ *
+ * @param[in]  値 (uint64_t)
+ * @return     計算結果 (Result)
+ */
+static ns::Result gen_res(std::uint64_t k) {
+  ns::Result res;
+
+  for (unsigned int v = 0; v < ns::kNumVal; ++v) {
+    ns::set_val(res, v, static_cast<double>(k));
+  }
+  return res;
+}
+
+/*
+ * @brief      購読側のエラー終了の確認（子プロセスで生成）
+ *
+ * @param[in]  共有メモリ名 (string)
+ * @return     エラー終了 (bool)
+ */
+static bool is_rejected(const std::string& name) {
+  pid_t pid;
+  int st;
+
+  std::cout.flush();
+  pid = fork();
+  if (pid == 0) {
+    std::freopen("/dev/null", "w", stdout);
+    ns::ShmSub o_s(name);
+    struct timespec ts;
+    ns::Result res;
+    o_s.read(ts, res);
+    _exit(EXIT_SUCCESS);
+  }
+  if (pid < 0 || waitpid(pid, &st, 0) != pid) return false;
+
+  return WIFEXITED(st) && WEXITSTATUS(st) == EXIT_FAILURE;
+}
+
+int main() {
+  static constexpr std::uint64_t kN = 200000;  // 公開の回数
+  const std::string name = "/ephjcg_test_" + std::to_string(getpid());
+  const std::string name_ng = name + "_ng";
+  int ret = EXIT_SUCCESS;
+
+  shm_unlink(name.c_str());
+  {
+    ns::ShmPub o_p(name);
+    ns::ShmSub o_s(name);
+    struct timespec ts;
+    struct timespec ts_0 = {1609459200, 123456789};
+    ns::Result res;
+    ns::Result res_0 = gen_res(7);
+    bool ok;
+
+    // 1件
+    ok = !o_s.read(ts, res) && o_s.get_seq() == 0;
+    o_p.publish(ts_0, res_0);
+    ok = ok && o_s.read(ts, res) && o_s.get_seq() == 2
+       && ts.tv_sec == ts_0.tv_sec && ts.tv_nsec == ts_0.tv_nsec
+       && std::memcmp(&res, &res_0, sizeof(ns::Result)) == 0;
+    if (!ok) {
+      std::cout << "[NG] Shm: publish/read round trip" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Shm: publish/read round trip" << std::endl;
+    }
+
+    // 書き込みと読み取りの並行
+    std::atomic<bool> done(false);
+    std::thread th([&o_p, &done]() {
+      for (std::uint64_t k = 1; k <= kN; ++k) {
+        struct timespec t = {static_cast<std::time_t>(k), static_cast<long>(k)};
+        o_p.publish(t, gen_res(k));
+      }
+      done.store(true);
+    });
+    std::uint64_t n_read = 0;
+    std::uint64_t n_torn = 0;
+    std::uint64_t k_prev = 0;
+    while (!done.load()) {
+      o_s.read(ts, res);
+      std::uint64_t k = static_cast<std::uint64_t>(ts.tv_sec);
+      if (k == 1609459200) continue;  // 並行する公開の開始前
+      ++n_read;
+      if (static_cast<std::uint64_t>(ts.tv_nsec) != k || k < k_prev) ++n_torn;
+      for (unsigned int v = 0; v < ns::kNumVal; ++v) {
+        if (ns::get_val(res, v) != static_cast<double>(k)) {
+          ++n_torn;
+          break;
+        }
+      }
+      k_prev = k;
+    }
+    th.join();
+    ok = o_s.read(ts, res) && static_cast<std::uint64_t>(ts.tv_sec) == kN
+       && o_s.get_seq() == 2 * (kN + 1);
+    if (!ok || n_torn > 0) {
+      std::cout << "[NG] Shm: " << n_torn << " torn / " << n_read << " reads"
+                << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Shm: 0 torn / " << n_read << " concurrent reads"
+                << std::endl;
+    }
+  }
+  shm_unlink(name.c_str());
+
+  // 不正な共有メモリ
+  {
+    bool ok = is_rejected(name_ng);  // 存在しない
+    int fd = shm_open(name_ng.c_str(), O_CREAT | O_RDWR, 0600);
+    ok = ok && fd >= 0 && ftruncate(fd, 8) == 0;
+    ok = ok && is_rejected(name_ng);  // 小さすぎる
+    ok = ok && ftruncate(fd, sizeof(ns::ShmSeg)) == 0;
+    ok = ok && is_rejected(name_ng);  // 識別子が異なる（全て 0）
+    if (fd >= 0) close(fd);
+    shm_unlink(name_ng.c_str());
+    if (!ok) {
+      std::cout << "[NG] ShmSub rejects missing/short/invalid segments" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] ShmSub rejects missing/short/invalid segments" << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,184 @@
+/***********************************************************
+  テスト: 恒星の係数の読み込み（File::get_star）・視位置（Star）
+
+  * 恒星数・係数の数が係数ファイルの恒星の区分（"No." の数, N の最大値 + 1）と
+    一致し、先頭・末尾の恒星の番号・名称・適用期間・係数が読み込まれることを
+    確認する。
+  * 一括計算（恒星方向の漸化式; kBlk 件を超える恒星数）の R.A., Dec.,
+    グリニッジ時角が、恒星1件毎の cos(i acos(x)) による計算と一致することを
+    確認する。
+  * 多数の時刻の計算が、1時刻毎の計算と一致することを確認する。
+***********************************************************/
+#include "eph_jcg.hpp"
+#include "file.hpp"
+#include "star.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      計算: 恒星1件（cos(i acos(x)) による直接計算）
+ *
+ * @param[in]  恒星の係数 (StarCat)
+ * @param[in]  恒星の添字 (size_t)
+ * @param[in]  時刻引数 (double)
+ * @param[out] R.A.（h） (double&)
+ * @param[out] Dec.（°） (double&)
+ * @return     <none>
+ */
+static void calc_one(const ns::StarCat& cat, std::size_t j, double tm,
+                     double& ra, double& dec) {
+  const std::size_t n = cat.no.size();
+  double x = (2.0 * tm - (cat.a[j] + cat.b[j])) / (cat.b[j] - cat.a[j]);
+  double th;
+
+  x  = std::min(1.0, std::max(-1.0, x));
+  th = acos(x);
+  ra  = 0.0;
+  dec = 0.0;
+  for (unsigned int i = 0; i < cat.n_coef; ++i) {
+    ra  += cat.c_ra [i * n + j] * cos(i * th);
+    dec += cat.c_dec[i * n + j] * cos(i * th);
+  }
+  ra = std::fmod(ra, 24.0);
+  if (ra < 0.0) ra += 24.0;
+}
+
+int main() {
+  static constexpr char        kFile[] = "txt/na20-data.txt";
+  static constexpr unsigned int kNumTm = 50;           // 時刻数
+  static constexpr std::time_t  kT0    = 1577836800;   // 2020-01-01 00:00:00
+  static constexpr std::time_t  kStep  = 631139;       // 時刻間隔（秒）
+  std::unique_ptr<ns::Param> prm(new ns::Param);       // 係数
+  ns::StarCat cat;                                     // 恒星の係数
+  ns::File o_f;
+  std::size_t n_no = 0;       // ファイル内の "No." の数
+  unsigned int n_max = 0;     // ファイル内の N の最大値
+  int ret = EXIT_SUCCESS;
+
+  // ファイルの恒星の区分を直接数える
+  {
+    std::ifstream ifs(kFile);
+    std::string ln;
+    bool in_star = false;
+    while (std::getline(ifs, ln)) {
+      if (!in_star) {
+        in_star = ln.find("恒星") != std::string::npos;
+        continue;
+      }
+      for (std::size_t p = ln.find("No."); p != std::string::npos;
+           p = ln.find("No.", p + 1)) ++n_no;
+      // 係数の行（N, R.A., Dec., ...）
+      std::size_t p = ln.find_first_not_of(' ');
+      if (p != std::string::npos && std::isdigit(static_cast<unsigned char>(ln[p]))
+          && ln.find('.') != std::string::npos) {
+        n_max = std::max(n_max, static_cast<unsigned int>(std::stoul(ln.substr(p))));
+      }
+    }
+  }
+
+  // 読み込み
+  o_f.get_star(2020, cat);
+  o_f.get_param(2020, *prm);
+  {
+    const std::size_t n = cat.no.size();
+    bool ok = n > 0 && n == n_no && cat.n_coef == n_max + 1 && cat.year == 2020
+           && cat.c_ra.size() == n * cat.n_coef && cat.c_dec.size() == n * cat.n_coef
+           && cat.no.front() == 1 && cat.name.front() == "Polaris"
+           && cat.no.back() == n && cat.a.back() == 0.0 && cat.b.back() == 367.0
+           && cat.c_ra [0] ==  2.961283 && cat.c_dec[0] == 89.35011
+           && cat.c_ra [(cat.n_coef - 1) * n + n - 1] == 0.000003
+           && cat.c_dec[(cat.n_coef - 1) * n + n - 1] == 0.00001;
+    if (!ok) {
+      std::cout << "[NG] File::get_star: " << n << " / " << n_no << " stars, "
+                << cat.n_coef << " / " << n_max + 1 << " coefficients" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] File::get_star: " << n << " stars, " << cat.n_coef
+                << " coefficients" << std::endl;
+    }
+  }
+
+  // 一括計算 と 恒星1件毎の計算（恒星を 3 倍に複製し、kBlk 件を超えさせる）
+  {
+    const std::size_t n0 = cat.no.size();
+    ns::StarCat big = cat;
+    std::size_t j;
+    unsigned int i;
+    big.no.clear();
+    big.a.clear();
+    big.b.clear();
+    for (j = 0; j < 3 * n0; ++j) {
+      big.no.push_back(j + 1);
+      big.a.push_back(cat.a[j % n0]);
+      big.b.push_back(cat.b[j % n0]);
+    }
+    big.c_ra.assign(big.n_coef * 3 * n0, 0.0);
+    big.c_dec.assign(big.n_coef * 3 * n0, 0.0);
+    for (i = 0; i < big.n_coef; ++i) {
+      for (j = 0; j < 3 * n0; ++j) {
+        big.c_ra [i * 3 * n0 + j] = cat.c_ra [i * n0 + j % n0];
+        big.c_dec[i * 3 * n0 + j] = cat.c_dec[i * n0 + j % n0];
+      }
+    }
+    ns::Star o_s(big);
+    ns::EphJcg o_e(*prm);
+    ns::Result res;
+    std::vector<struct timespec> ts(kNumTm);
+    std::vector<double> ra(kNumTm * o_s.size());
+    std::vector<double> dec(kNumTm * o_s.size());
+    std::vector<double> gha(kNumTm * o_s.size());
+    std::vector<double> ra_1(o_s.size());
+    std::vector<double> dec_1(o_s.size());
+    std::vector<double> gha_1(o_s.size());
+    double err = 0.0;
+    unsigned int n_ng = 0;
+    unsigned int k;
+
+    for (k = 0; k < kNumTm; ++k) {
+      ts[k].tv_sec  = kT0 + static_cast<std::time_t>(k) * kStep;
+      ts[k].tv_nsec = static_cast<long>(k) * 19999999 % 1000000000;
+    }
+    o_s.calc(o_e, ts.data(), kNumTm, ra.data(), dec.data(), gha.data());
+    for (k = 0; k < kNumTm; ++k) {
+      o_e.calc(ts[k], res);
+      o_s.calc(o_e, res, ra_1.data(), dec_1.data(), gha_1.data());
+      for (j = 0; j < o_s.size(); ++j) {
+        double r;
+        double d;
+        calc_one(big, j, o_e.get_tm(), r, d);
+        double dr = std::abs(ra_1[j] - r);
+        err = std::max({err, std::min(dr, 24.0 - dr), std::abs(dec_1[j] - d),
+                        std::abs(gha_1[j] - (res.r + o_e.get_f() * 24.0 - ra_1[j]))});
+        if (ra_1[j]  != ra [k * o_s.size() + j] ||
+            dec_1[j] != dec[k * o_s.size() + j] ||
+            gha_1[j] != gha[k * o_s.size() + j]) ++n_ng;
+      }
+    }
+    if (err > 1.0e-12) {
+      std::cout << "[NG] Star: batch vs single-star: max error " << err << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Star: " << o_s.size() << " stars match single-star evaluation"
+                << std::endl;
+    }
+    if (n_ng > 0) {
+      std::cout << "[NG] Star: " << n_ng << " multi-time values differ" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Star: " << kNumTm << " times match per-time calc" << std::endl;
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,149 @@
+/***********************************************************
+  テスト: 係数・ΔT の保持（Store）の再読み込み
+
+  * 一時ディレクトリに txt/ のファイルへのシンボリックリンクを作成し、
+    係数ファイルを不正なもの（途中まで・数値が不正）に差し替えても、
+    再読み込み（reload, watch）で終了・例外とならず、読み取り側が旧世代の
+    係数を参照し続けることを確認する。
+  * 正しいファイルに戻すと、次の世代に差し替わることを確認する。
+***********************************************************/
+#include "store.hpp"
+
+#include <chrono>
+#include <cstdlib>   // for EXIT_XXXX
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+/*
+ * @brief      ファイルの書き込み（一時ファイル経由で差し替え）
+ *
+ * @param[in]  ファイル名 (string)
+ * @param[in]  内容 (string)
+ * @return     <none>
+ */
+static void put_file(const std::string& f, const std::string& s) {
+  std::string f_tmp = f + ".tmp";
+
+  {
+    std::ofstream ofs(f_tmp, std::ios::binary);
+    ofs << s;
+  }
+  rename(f_tmp.c_str(), f.c_str());
+}
+
+/*
+ * @brief      状態の確認
+ *
+ * @param[ref] 保持 (Store)
+ * @param[in]  期待する世代 (uint64_t)
+ * @param[in]  期待する失敗回数 (uint64_t)
+ * @param[in]  期待する係数（2021 年） (Param)
+ * @return     一致 (bool)
+ */
+static bool is_state(ns::Store& st, std::uint64_t gen, std::uint64_t n_fail,
+                     const ns::Param& prm) {
+  ns::Store::Reader rd(st);
+  const ns::Param* p = rd.find(2021);
+
+  return rd.get().gen == gen && st.get_n_fail() == n_fail && p != nullptr
+      && std::memcmp(p, &prm, sizeof(ns::Param)) == 0;
+}
+
+int main() {
+  static constexpr char kF21[] = "txt/na21-data.txt";  // 差し替えるファイル
+  std::unique_ptr<ns::Param> prm(new ns::Param);      // 係数（2021 年）
+  std::vector<std::string> fs;                        // txt/ 内のファイル
+  std::string org;                                    // 元の内容
+  std::string bad;                                    // 不正な内容
+  char cwd[4096];
+  char dir[] = "/tmp/test_store_XXXXXX";
+  DIR* dp;
+  struct dirent* ent;
+  int ret = EXIT_SUCCESS;
+
+  // 一時ディレクトリ（txt/ 内のファイルへのリンク）
+  if (getcwd(cwd, sizeof(cwd)) == nullptr || mkdtemp(dir) == nullptr) {
+    std::cout << "[NG] Store: could not create a temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  dp = opendir("txt");
+  while (dp != nullptr && (ent = readdir(dp)) != nullptr) {
+    if (ent->d_name[0] != '.') fs.push_back(ent->d_name);
+  }
+  if (dp != nullptr) closedir(dp);
+  {
+    std::ifstream ifs(kF21, std::ios::binary);
+    org.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  if (chdir(dir) != 0 || mkdir("txt", 0700) != 0) {
+    std::cout << "[NG] Store: could not enter " << dir << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (auto& f : fs) {
+    if (symlink((std::string(cwd) + "/txt/" + f).c_str(), ("txt/" + f).c_str()) != 0) {
+      std::cout << "[NG] Store: could not link " << f << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    ns::Store st;
+    {
+      ns::Store::Reader rd(st);
+      *prm = *rd.find(2021);
+    }
+
+    // 途中までのファイル（reload）
+    put_file(kF21, org.substr(0, org.size() / 2));
+    if (st.reload() || !is_state(st, 1, 1, *prm)) {
+      std::cout << "[NG] Store: truncated file replaced generation 1" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Store: truncated file rejected, generation 1 kept" << std::endl;
+    }
+
+    // 数値が不正なファイル（watch; 監視スレッドが終了しないこと）
+    bad = org;
+    bad.replace(bad.find("22.730213"), 9, "      -.-");
+    st.watch(10);
+    put_file(kF21, bad);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    if (!is_state(st, 1, 2, *prm)) {
+      std::cout << "[NG] Store: malformed file replaced generation 1" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Store: malformed file rejected by watch, generation 1 kept"
+                << std::endl;
+    }
+
+    // 正しいファイルに戻す
+    put_file(kF21, org);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    st.unwatch();
+    if (!is_state(st, 2, 2, *prm)) {
+      std::cout << "[NG] Store: restored file not loaded" << std::endl;
+      ret = EXIT_FAILURE;
+    } else {
+      std::cout << "[OK] Store: restored file loaded as generation 2" << std::endl;
+    }
+  }
+
+  // 後始末
+  for (auto& f : fs) unlink(("txt/" + f).c_str());
+  rmdir("txt");
+  if (chdir(cwd) == 0) rmdir(dir);
+
+  return ret;
+}
@@ -0,0 +1,84 @@
+/***********************************************************
+  テスト: 高度・方位角（Topo）の周縁補正
+
+  * 太陽・月について、下辺 < 中心 < 上辺 の順であり、
+    中心との差が視半径（高度による増減（月で最大 0.3% 程度）を含む）で
+    あることを確認する。
+***********************************************************/
+#include "eph_jcg.hpp"
+#include "topo.hpp"
+
+#include <cmath>
+#include <cstdlib>   // for EXIT_XXXX
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace ns = ephemeris_jcg;
+
+int main() {
+  static constexpr unsigned int kNumTm = 24;  // 時刻数
+  static constexpr long kStep = 1299709;      // 時刻間隔（秒）
+  const unsigned int body[2] = {ns::kGrpSun, ns::kGrpMon};
+  std::unique_ptr<ns::Param> prm(new ns::Param);  // 係数
+  std::vector<double> lat;                         // 緯度
+  std::vector<double> lon;                         // 経度
+  std::vector<double> h_l, h_c, h_u, zn;           // 高度（下辺・中心・上辺）, 方位角
+  ns::File o_f;
+  ns::DateTime dt = {2021, 1, 1, 0, 0, 0, 0};
+  ns::Result res;
+  struct timespec ts;
+  unsigned long n_ng = 0;
+  unsigned long n_chk = 0;
+  unsigned int k;
+  std::size_t i;
+
+  try {
+    for (int la = -60; la <= 60; la += 30) {
+      for (int lo = -180; lo < 180; lo += 30) {
+        lat.push_back(la);
+        lon.push_back(lo);
+      }
+    }
+    ns::Topo o_t(lat.data(), lon.data(), nullptr, lat.size());
+    h_l.resize(o_t.size());
+    h_c.resize(o_t.size());
+    h_u.resize(o_t.size());
+    zn.resize(o_t.size());
+    o_f.get_param(dt.year, *prm);
+    ns::EphJcg o_e(*prm);
+    for (k = 0; k < kNumTm; ++k) {
+      ts = ns::dt2ts(dt);
+      ts.tv_sec += k * kStep;
+      o_e.calc(ts, res);
+      for (auto b : body) {
+        double sd = (b == ns::kGrpSun) ? res.sun_sd / 60.0 : res.mon_sd / 60.0;
+        o_t.calc_body(res, b, h_l.data(), zn.data(), ns::kLimbLower);
+        o_t.calc_body(res, b, h_c.data(), zn.data(), ns::kLimbCenter);
+        o_t.calc_body(res, b, h_u.data(), zn.data(), ns::kLimbUpper);
+        for (i = 0; i < o_t.size(); ++i) {
+          ++n_chk;
+          double d_l = h_c[i] - h_l[i];
+          double d_u = h_u[i] - h_c[i];
+          if (!(h_l[i] < h_c[i] && h_c[i] < h_u[i])
+              || std::abs(d_l - d_u) > 1.0e-9
+              || std::abs(d_u - sd) > sd * 0.02) {
+            if (n_ng++ < 10) {
+              std::cout << "  " << ns::gen_time_str(ts) << " body " << b
+                        << " (" << lat[i] << ", " << lon[i] << "): "
+                        << h_l[i] << " " << h_c[i] << " " << h_u[i] << std::endl;
+            }
+          }
+        }
+      }
+    }
+    std::cout << (n_ng == 0 ? "[OK] " : "[NG] ") << "Topo limb: "
+              << n_ng << " / " << n_chk << " failed" << std::endl;
+  } catch (...) {
+    std::cerr << "EXCEPTION!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return n_ng == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
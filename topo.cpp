@@ -0,0 +1,162 @@
+#include "topo.hpp"
+
+#include <cmath>
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr double kPi   = atan(1.0) * 4;  // PI
+static constexpr double kD2R  = kPi / 180.0;    // 度 -> ラジアン
+static constexpr double kR2D  = 180.0 / kPi;    // ラジアン -> 度
+static constexpr double kRe   = 6378137.0;      // 地球赤道半径 (m)
+static constexpr double kHp0  = 8.794143;       // 1 AU での地平視差 (″)
+
+/*
+ * @brief      取得: 天体の地心位置
+ *             * 地平視差は 月: H.P., その他: 8.794″/ Dist.
+ *
+ * @param[in]  計算結果 (Result)
+ * @param[in]  天体 (unsigned int; Grp)
+ * @return     天体の地心位置 (BodyPos)
+ */
+BodyPos get_body_pos(const Result& res, unsigned int b) {
+  BodyPos bp;
+  double  dec;  // 赤緯（ラジアン）
+
+  dec      = get_val(res, kValSunDec + b * 3) * kD2R;
+  bp.sin_d = sin(dec);
+  bp.cos_d = cos(dec);
+  bp.gha   = get_val(res, kValSunHg + b) * 15.0;
+  bp.sd    = 0.0;
+  if (b == kGrpMon) {
+    bp.sin_p = sin(res.mon_hp * kD2R);
+    bp.sd    = res.mon_sd / 60.0;
+  } else {
+    bp.sin_p = sin(kHp0 / 3600.0 / get_val(res, kValSunDist + b * 3) * kD2R);
+    if (b == kGrpSun) bp.sd = res.sun_sd / 60.0;
+  }
+
+  return bp;
+}
+
+/*
+ * @brief       計算: 高度・方位角（1天体・1観測地点）
+ *              * 地心の赤緯・グリニッジ時角から地心高度・方位角を求め、
+ *                地平視差により観測地点の高さを含めた地表からの高度に補正する。
+ *                  sin h = sin φ sin δ + cos φ cos δ cos LHA
+ *                  tan h' = (sin h - ρ sin π) / cos h
+ *              * 周縁の指定により視半径（月は高度による増大を含む）を加減する。
+ *              * Topo, CelFix で共用する。
+ *
+ * @param[in]   天体の地心位置 (BodyPos)
+ * @param[in]   sin(緯度) (double)
+ * @param[in]   cos(緯度) (double)
+ * @param[in]   経度（°; 東経を正） (double)
+ * @param[in]   地心距離（地球赤道半径 = 1） (double)
+ * @param[in]   周縁 (int; Limb)
+ * @param[out]  方位角 Zn（°; 北から東回り） (double&)
+ * @return      高度 Hc（°） (double)
+ */
+double calc_alt_az(const BodyPos& bp, double sin_lat, double cos_lat,
+                   double lon, double rho, int limb, double& zn) {
+  double lha   = (bp.gha + lon) * kD2R;
+  double cos_h = cos(lha);
+  double sin_a = sin_lat * bp.sin_d + cos_lat * bp.cos_d * cos_h;
+  double cos_a = sqrt(1.0 - sin_a * sin_a);
+  double alt   = atan2(sin_a - rho * bp.sin_p, cos_a) * kR2D;
+
+  zn = atan2(-bp.cos_d * sin(lha),
+             bp.sin_d * cos_lat - bp.cos_d * sin_lat * cos_h) * kR2D;
+  if (zn < 0.0) zn += 360.0;
+
+  return alt + limb * bp.sd * (1.0 + rho * bp.sin_p * sin_a);
+}
+
+/*
+ * @brief  コンストラクタ
+ *         * 観測地点毎に sin(緯度), cos(緯度), 地心距離を前計算する。
+ *
+ * @param[in]  緯度配列（°; 北緯を正） (const double*)
+ * @param[in]  経度配列（°; 東経を正） (const double*)
+ * @param[in]  高さ配列（m） (const double*; nullptr の場合 0 m)
+ * @param[in]  観測地点数 (size_t)
+ */
+Topo::Topo(const double* lat, const double* lon, const double* ht,
+           std::size_t n)
+    : sin_lat(n), cos_lat(n), lon(lon, lon + n), rho(n) {
+  std::size_t i;
+
+  try {
+    for (i = 0; i < n; ++i) {
+      sin_lat[i] = sin(lat[i] * kD2R);
+      cos_lat[i] = cos(lat[i] * kD2R);
+      rho[i]     = 1.0 + (ht == nullptr ? 0.0 : ht[i]) / kRe;
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief   観測地点数
+ *
+ * @param   <none>
+ * @return  観測地点数 (size_t)
+ */
+std::size_t Topo::size() const {
+  return lon.size();
+}
+
+/*
+ * @brief       計算: 高度・方位角（全天体）
+ *              * 出力配列は天体（Grp 順: 太陽 - 月）毎に観測地点数分ずつ連続する。
+ *                （要素数: kNumBody * 観測地点数）
+ *
+ * @param[in]   計算結果 (Result)
+ * @param[out]  高度 Hc 配列（°） (double*)
+ * @param[out]  方位角 Zn 配列（°; 北から東回り） (double*)
+ * @param[in]   周縁 (int; Limb)
+ * @return      <none>
+ */
+void Topo::calc(const Result& res, double* hc, double* zn, int limb) const {
+  unsigned int b;
+
+  try {
+    for (b = 0; b < kNumBody; ++b) {
+      calc_body(res, b, hc + b * size(), zn + b * size(), limb);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算: 高度・方位角（1天体）
+ *              * 天体の地心位置（get_body_pos）を求め、観測地点毎に calc_alt_az で
+ *                地表からの高度・方位角を求める。
+ *
+ * @param[in]   計算結果 (Result)
+ * @param[in]   天体 (unsigned int; Grp)
+ * @param[out]  高度 Hc 配列（°） (double*)
+ * @param[out]  方位角 Zn 配列（°; 北から東回り） (double*)
+ * @param[in]   周縁 (int; Limb)
+ * @return      <none>
+ */
+void Topo::calc_body(const Result& res, unsigned int b,
+                     double* hc, double* zn, int limb) const {
+  const std::size_t n = size();
+  BodyPos bp;     // 天体の地心位置
+  std::size_t i;
+
+  try {
+    bp = get_body_pos(res, b);
+    for (i = 0; i < n; ++i) {
+      hc[i] = calc_alt_az(bp, sin_lat[i], cos_lat[i], lon[i], rho[i], limb, zn[i]);
+    }
+  } catch (...) {
+    throw;
+  }
+}
+
+}  // namespace ephemeris_jcg
+
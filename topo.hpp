@@ -0,0 +1,66 @@
+#ifndef EPHEMERIS_JCG_TOPO_HPP_
+#define EPHEMERIS_JCG_TOPO_HPP_
+
+#include "file.hpp"
+#include "result.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Constants
+// -------------------------------------
+static constexpr unsigned int kNumBody = kGrpMon + 1;  // 天体の数（太陽 - 月; Grp 順）
+
+// 周縁（太陽・月のみ有効; 値は中心の高度に加える視半径の符号）
+enum Limb : int {
+  kLimbCenter =  0,  // 中心
+  kLimbLower  = -1,  // 下辺（中心 - 視半径）
+  kLimbUpper  =  1,  // 上辺（中心 + 視半径）
+};
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 天体の地心位置（高度計算用）
+struct BodyPos {
+  double sin_d;  // sin(赤緯)
+  double cos_d;  // cos(赤緯)
+  double gha;    // グリニッジ時角（°）
+  double sin_p;  // sin(地平視差)
+  double sd;     // 視半径（°; 太陽・月以外は 0）
+};
+
+// -------------------------------------
+//   Functions
+// -------------------------------------
+BodyPos get_body_pos(const Result&, unsigned int);  // 取得: 天体の地心位置
+double calc_alt_az(const BodyPos&, double, double, double, double, int,
+                   double&);                         // 計算: 高度・方位角（1地点）
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 高度・方位角（多数の観測地点; 列指向）
+// * 観測地点毎の値を前計算して保持し、1時刻分の計算結果（天体位置）を
+//   全観測地点に対して使い回す。
+class Topo {
+  std::vector<double> sin_lat;  // sin(緯度)
+  std::vector<double> cos_lat;  // cos(緯度)
+  std::vector<double> lon;      // 経度（°; 東経を正）
+  std::vector<double> rho;      // 地心距離（地球赤道半径 = 1）
+
+public:
+  Topo(const double*, const double*, const double*, std::size_t);  // コンストラクタ
+  std::size_t size() const;                                        // 観測地点数
+  void calc(const Result&, double*, double*, int = kLimbCenter) const;  // 計算: 高度・方位角
+  void calc_body(const Result&, unsigned int, double*, double*,
+                 int = kLimbCenter) const;                         // 計算: 高度・方位角（1天体）
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+
@@ -0,0 +1,105 @@
+#include "trunc.hpp"
+
+namespace ephemeris_jcg {
+
+// 定数
+static constexpr double kSecHour = 54000.0;  // 1h あたりの角度（″）
+static constexpr double kSecDeg  = 3600.0;   // 1° あたりの角度（″）
+static constexpr double kSecRad  = 180.0 * kSecDeg / (atan(1.0) * 4);  // 1rad（″）
+
+/*
+ * @brief  コンストラクタ
+ *
+ * @param[in]  許容誤差 (double; ″)
+ */
+Trunc::Trunc(double tol) : tol(tol) {}
+
+/*
+ * @brief       計算: 打ち切り
+ *              * 統計は呼び出し元で 0 初期化し、複数年分を累積できる。
+ *                （誤差の上限は最大値、項数は合計）
+ *              * R.A., R は許容誤差の半分で打ち切り、hG（= R - R.A.）の誤差の
+ *                上限（R, R.A. の上限の和）も角度の誤差の上限に含める。
+ *
+ * @param[ref]  係数 (Param)
+ * @param[ref]  打ち切りの結果 (TruncStat)
+ * @return      <none>
+ */
+void Trunc::calc(Param& prm, TruncStat& stat) const {
+  unsigned int g;     // 区分
+  unsigned int n_q;   // 区分内の値の数
+  unsigned int i;     // 適用期間
+  unsigned int q;     // 値
+  unsigned int j;
+  double tol_q;       // 許容誤差（値の単位）
+  double d_min;       // 距離の下限（AU）
+  double err;         // 誤差の上限（値の単位）
+
+  try {
+    for (g = 0; g < kNumGrp; ++g) {
+      GrpParam& gp = prm.grp[g];
+      n_q = (g == kGrpR) ? 2 : kNumQty;
+      for (i = 0; i < gp.n_seg; ++i) {
+        Seg& seg = gp.seg[i];
+        for (q = 0; q < n_q; ++q) {
+          d_min = 0.0;
+          if (q == kQtyRa) {
+            tol_q = tol / 2.0 / kSecHour;
+          } else if (q == kQtyDist && g != kGrpMon) {
+            d_min = seg.c[0][q];
+            for (j = 1; j < gp.n_coef; ++j) d_min -= std::abs(seg.c[j][q]);
+            tol_q = (d_min > 0.0) ? tol / kSecRad * d_min : 0.0;
+          } else {
+            tol_q = tol / kSecDeg;
+          }
+          seg.n_c[q] = calc_n(seg, gp.n_coef, q, tol_q, err);
+          stat.n_term += seg.n_c[q];
+          stat.n_all  += gp.n_coef;
+          if (q == kQtyRa && g == kGrpR) {
+            stat.err_r  = std::max(stat.err_r,  err * kSecHour);
+          } else if (q == kQtyRa) {
+            stat.err_ra = std::max(stat.err_ra, err * kSecHour);
+          } else if (q == kQtyDist && g != kGrpMon) {
+            if (d_min > 0.0) stat.err_dist = std::max(stat.err_dist, err / d_min);
+          } else {
+            stat.err_ang = std::max(stat.err_ang, err * kSecDeg);
+          }
+        }
+      }
+    }
+    stat.err_ang = std::max({stat.err_ang, stat.err_r, stat.err_ra,
+                             stat.err_r + stat.err_ra});
+  } catch (...) {
+    throw;
+  }
+}
+
+/*
+ * @brief       計算: 項数
+ *              * 末尾から除く係数の絶対値を足し、許容誤差を超える手前までを除く。
+ *                （定数項は常に残す）
+ *
+ * @param[in]   係数 (Seg)
+ * @param[in]   係数の数 (unsigned int)
+ * @param[in]   値 (unsigned int; Qty)
+ * @param[in]   許容誤差（値の単位） (double)
+ * @param[out]  誤差の上限（値の単位） (double)
+ * @return      項数 (unsigned int)
+ */
+unsigned int Trunc::calc_n(const Seg& seg, unsigned int n, unsigned int q,
+                           double tol_q, double& err) const {
+  double s;
+
+  err = 0.0;
+  while (n > 1) {
+    s = err + std::abs(seg.c[n - 1][q]);
+    if (s > tol_q) break;
+    err = s;
+    --n;
+  }
+
+  return n;
+}
+
+}  // namespace ephemeris_jcg
+
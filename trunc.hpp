@@ -0,0 +1,51 @@
+#ifndef EPHEMERIS_JCG_TRUNC_HPP_
+#define EPHEMERIS_JCG_TRUNC_HPP_
+
+#include "file.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ephemeris_jcg {
+
+// -------------------------------------
+//   Structs
+// -------------------------------------
+// 打ち切りの結果
+// * 誤差の上限は、除いた係数の絶対値の和（|cos(iθ)| <= 1 なので保証値）。
+// * hG（= R - R.A.）は R, R.A. の誤差が加わるので、err_ang は err_r + err_ra も含む。
+struct TruncStat {
+  double err_ang;        // 誤差の上限: 角度（″; hG を含む全ての角度の値）
+  double err_r;          // 誤差の上限: R（″; 時角を角度に換算）
+  double err_ra;         // 誤差の上限: R.A.（″; 時角を角度に換算）
+  double err_dist;       // 誤差の上限: 距離（相対誤差; Dist.）
+  unsigned long n_term;  // 項数の合計（打ち切り後）
+  unsigned long n_all;   // 項数の合計（打ち切り前）
+};
+
+// -------------------------------------
+//   Classes
+// -------------------------------------
+// 係数の打ち切り（許容誤差指定）
+// * 適用期間・値毎に、除く係数の絶対値の和が許容誤差以下となる最短の先頭部分のみを
+//   計算に使うようにする。（Seg::n_c; 係数そのものは変更しない）
+// * 許容誤差は角度（″）で指定し、値の単位に換算する。
+//   - R.A., R（h）: 許容誤差 / 2 / 54000（hG = R - R.A. も許容誤差以下とする）
+//   - Dec., ε, H.P.（°）: 許容誤差 / 3600
+//   - Dist.（AU）: 許容誤差（rad） * 適用期間内の距離の下限（相対誤差を揃える）
+class Trunc {
+  double tol;  // 許容誤差（″）
+
+public:
+  explicit Trunc(double);                // コンストラクタ
+  void calc(Param&, TruncStat&) const;   // 計算: 打ち切り（結果は累積）
+
+private:
+  unsigned int calc_n(const Seg&, unsigned int, unsigned int, double,
+                      double&) const;    // 計算: 項数
+};
+
+}  // namespace ephemeris_jcg
+
+#endif
+